@@ -0,0 +1,1893 @@
+/*
+
+    BasicXMLParser.hpp
+
+    Include file for XML parsing class template, with the handler
+    called statically so that its callbacks can be inlined
+
+*/
+
+#ifndef BASICXMLPARSER_HPP
+#define BASICXMLPARSER_HPP
+
+#include <string>
+#include <optional>
+#include <string_view>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cstdint>
+#include <stdlib.h>
+#include "XMLParserHandler.hpp"
+#include "XMLParserInput.hpp"
+#include "refillBuffer.hpp"
+#include "scanCharacters.hpp"
+#include "scanName.hpp"
+#include "skipMarkup.hpp"
+#include "XMLParserError.hpp"
+
+// trace parsing
+#ifdef TRACE
+#undef TRACE
+#include <iomanip>
+#define HEADER(m) std::clog << std::setw(10) << std::left << m <<"\t"
+#define FIELD(l, n) l << ":|" << n << "| "
+#define TRACE0(m)
+#define TRACE1(m, l1, n1) HEADER(m) << FIELD(l1,n1) << '\n';
+#define TRACE2(m, l1, n1, l2, n2) HEADER(m) << FIELD(l1,n1) << FIELD(l2,n2) << '\n';
+#define TRACE3(m, l1, n1, l2, n2, l3, n3) HEADER(m) << FIELD(l1,n1) << FIELD(l2,n2) << FIELD(l3,n3) << '\n';
+#define TRACE4(m, l1, n1, l2, n2, l3, n3, l4, n4) HEADER(m) << FIELD(l1,n1) << FIELD(l2,n2) << FIELD(l3,n3) << FIELD(l4,n4) << '\n';
+#define GET_TRACE(_1,_2,_3,_4,_5,_6,_7,_8,_9,NAME,...) NAME
+#define TRACE(...) GET_TRACE(__VA_ARGS__, TRACE4, _UNUSED, TRACE3, _UNUSED, TRACE2, _UNUSED, TRACE1, _UNUSED, TRACE0)(__VA_ARGS__)
+#else
+#define TRACE(...)
+#endif
+
+/*
+    Events of a handler with an eventMask, e.g., one that redeclares the
+    eventMask of XMLParserHandler
+*/
+template <class Handler>
+constexpr auto handlerEventMask(int) -> decltype(static_cast<unsigned int>(Handler::eventMask)) {
+    return Handler::eventMask;
+}
+
+/*
+    Events of a handler without an eventMask, i.e., all of them
+*/
+template <class Handler>
+constexpr unsigned int handlerEventMask(long) {
+    return XMLParserHandler::ALL_EVENTS;
+}
+
+/*
+    Whether a handler with pullsEvents, e.g., the handler of XMLReader,
+    has parse() return after each token
+*/
+template <class Handler>
+constexpr auto handlerPullsEvents(int) -> decltype(static_cast<bool>(Handler::pullsEvents)) {
+    return Handler::pullsEvents;
+}
+
+/*
+    Whether a handler without pullsEvents has parse() return after each token, i.e., never
+*/
+template <class Handler>
+constexpr bool handlerPullsEvents(long) {
+    return false;
+}
+
+/*
+    Whether a handler with internsNames, e.g., srcFactsParser, is called
+    with the ID of the element name in the start and end tag events. The
+    names are interned in the ElementNames elementNames of the handler,
+    so the IDs are its own, with no second table to look a name up in
+*/
+template <class Handler>
+constexpr auto handlerInternsNames(int) -> decltype(static_cast<bool>(Handler::internsNames)) {
+    return Handler::internsNames;
+}
+
+/*
+    Whether a handler without internsNames is called with the ID of the element name, i.e., never
+*/
+template <class Handler>
+constexpr bool handlerInternsNames(long) {
+    return false;
+}
+
+/*
+    Handler is any class with the callbacks of XMLParserHandler. They are
+    called statically, so for a final handler class, or one that does not
+    derive from XMLParserHandler, empty callbacks compile away and the
+    others can be inlined into parse(). Events that are not in the
+    eventMask of the handler are not called, and are skipped with as
+    little work as possible, e.g., end tags without their names.
+*/
+template <class Handler>
+class BasicXMLParser {
+private:
+    // events the handler is called for
+    static constexpr unsigned int eventMask = handlerEventMask<Handler>(0);
+
+    // parse() returns after each token, and resumes on the next call
+    static constexpr bool pullsEvents = handlerPullsEvents<Handler>(0);
+
+    // start and end tag events have the ID of the element name after the
+    // localName, e.g., handleElementStartTag(qName, prefix, localName, nameID, depth)
+    static constexpr bool internsNames = handlerInternsNames<Handler>(0);
+
+    /*
+        Traces the start of an XML document
+        Input: N/A
+        Output: Trace
+    */
+    void beginParsing();
+
+    /*
+        Traces the end of an XML document
+        Input: N/A
+        Output: Trace
+    */
+    void endParsing();
+
+    /*
+        Returns if the parser is inside a namespace
+        Input: Start iterator of segment to parse
+        Output: Bool value for if the iterator is inside a namespace
+    */
+    bool isNamespace(const char* &cursor);
+
+    /*
+        Returns if the parser is inside an XML comment
+        AND is NOT inside a namespace OR attribute
+        Input: Start iterator of segment to parse
+        Output: Bool value for if the iterator is inside an XML comment
+    */
+    bool isXMLComment(const char* &cursor);
+
+    /*
+        Returns if the parser is inside CDATA
+        AND is NOT inside a namespace, attribute, OR XML comment
+        Input: Start iterator of segment to parse
+        Output: Bool value for if the iterator is inside CDATA
+    */
+    bool isCDATA(const char* &cursor);
+
+    /*
+        Returns if the parser is inside an XML declaration
+        AND is NOT inside a namespace, attribute, XML comment, OR CDATA
+        Input: Start iterator of segment to parse
+        Output: Bool value for if the iterator is inside an XML declaration
+    */
+    bool isXMLDecl(const char* &cursor);
+
+    /*
+        Parses an xml namespace
+        Input: Start and end iterators of segment to parse; depth; and prefix and uri variables by ref
+        Output: Parsed prefix and uri by ref; adjusted depth value by ref
+    */
+    void parseNamespace(const char* &cursor, const char* &cursorEnd, int &depth, std::string_view &prefix, std::string_view &uri);
+
+    /*
+        Parses an xml attribute
+        Input: Start and end iterators of segment to parse; depth; and qName, prefix, localName, and value variables by ref
+        Output: qName, prefix, localName, and value by ref; adjusted depth value by ref
+    */
+    void parseAttribute(const char* &cursor, const char* &cursorEnd, int &depth, std::string_view &qName, std::string_view &prefix, std::string_view &localName, std::string_view &value);
+
+    /*
+        Parses an xml comment
+        Input: Start and end iterators of segment to parse; comment variable by ref
+        Output: Parsed comment by ref
+    */
+    void parseComment(const char* &cursor, const char* &cursorEnd, std::string_view &comment);
+
+    /*
+        Parses xml CDATA
+        Input: Start and end iterators of segment to parse; characters variable by ref
+        Output: Parsed characters by ref
+    */
+    void parseCDATA(const char* &cursor, const char* &cursorEnd, std::string_view &characters);
+
+    /*
+        Verifies the XML declaration is complete
+        Input: Start and end iterators of segment to parse; tagEnd
+        Output: If declaration is incomplete, outputs error message and exits
+    */
+   void validateDeclaration(const char* &cursor, const char* &cursorEnd, const char* &tagEnd);
+
+    /*
+        Parses xml declaration
+        Input: Start and end iterators of segment to parse; startXMLDecl, endXMLDecl, and tagEnd; version, encoding, and standalone variables by ref
+        Output: Parsed version, encoding, and standalone as ref
+    */
+    void parseDeclaration(const char* &cursor, const char* &cursorEnd, std::string_view startXMLDecl, std::string_view endXMLDecl, const char* &tagEnd, std::string_view &version, std::optional<std::string_view> &encoding, std::optional<std::string_view> &standalone);
+
+    /*
+        Verifies the processing instruction is complete 
+        Input: Start and end iterators of segment to parse; tagEnd, endPI
+        Output: If instruction is incomplete, outputs error message and exits
+    */
+   void validateProcessInstruction(const char* &cursor, const char* &cursorEnd, const char* &tagEnd, std::string_view endPI);
+
+    /*
+        Parses xml processing instruction
+        Input: Start and end iterators of segment to parse; tagEnd; target and data variables by ref
+        Output: Parsed target and data as ref
+    */
+    void parseProcessInstruction(const char* &cursor, const char* &cursorEnd, const char* &tagEnd, std::string_view &target, std::string_view &data);
+
+    /*
+        Verifies the element end tag is complete
+        Input: Start and end iterators of segment to parse; tagEnd
+        Output: If element end tag is incomplete, outputs error message and exits
+    */
+   void validateEndTag(const char* &cursor, const char* &cursorEnd, const char* &tagEnd);
+
+    /*
+        Parses xml end tag
+        Input: Start and end iterators of segment to parse; depth; prefix, qName, and localName variables by ref
+        Output: Parsed prefix, qName, and localName as ref; adjusted depth value by ref
+    */
+    void parseEndTag(const char* &cursor, const char* &cursorEnd, int &depth, std::string_view &prefix, std::string_view &qName, std::string_view &localName);
+
+    /*
+        Verifies the element start tag is complete
+        Input: Start and end iterators of segment to parse; tagEnd
+        Output: If element start tag is incomplete, outputs error message and exits
+    */
+   void validateStartTag(const char* &cursor, const char* &cursorEnd, const char* &tagEnd);
+
+    /*
+        Parses xml start tag
+        Input: Start and end iterators of segment to parse; prefix, qName, and localName variables by ref
+        Output: Parsed prefix, qName, and localName as ref
+    */
+    void parseStartTag(const char* &cursor, const char* &cursorEnd, std::string_view &prefix, std::string_view &qName, std::string_view &localName);
+
+    /*
+        Parses character entity references
+        Input: Start iterator of segment to parse; characters variable by ref
+        Output: Parsed characters as ref
+    */
+    void parseCharEntity(const char* &cursor, std::string_view &characters);
+
+    /*
+        Parses character non-entity references
+        Input: Start and end iterators of segment to parse; characters and newlineCount variables by ref
+        Output: Parsed characters and their number of newlines as ref
+    */
+    void parseCharNonEntity(const char* &cursor, const char* &cursorEnd, std::string_view &characters, int &newlineCount);
+
+    /*
+        Refills the buffer from the input source or standard input, or
+        reports the end of input for a document that is already in memory
+        Input: Start and end iterators of segment to parse
+        Output: Number of bytes read (0 at EOF, -1 on error); adjusted iterators by ref
+    */
+    int refill(const char* &cursor, const char* &cursorEnd);
+
+    /*
+        Skips the rest of an element without events, from inside its start
+        tag, or from its content, up to and including its end tag
+        Input: Start and end iterators of segment to parse; whether the cursor is in the start tag
+        Output: Adjusted iterators by ref
+    */
+    void skipElementContent(const char* &cursor, const char* &cursorEnd, bool inStartTag);
+
+    /*
+        Stops the parse at a malformed construct, or an input error, which
+        parse() returns with its position. Never returns, so the compiler
+        keeps the error paths out of the way of the success path
+        Input: Error code, position of the error, and end of the buffer
+        Output: N/A
+    */
+    [[noreturn]] void error(XMLParserError::Code code, const char* position, const char* cursorEnd);
+
+    /*
+        Finds the position of an error in the document, e.g., of the start
+        of a comment that may be unterminated, while its bytes are in the buffer
+        Input: Error code, position of the error, and end of the buffer
+        Output: Error with its position
+    */
+    XMLParserError locateError(XMLParserError::Code code, const char* position, const char* cursorEnd);
+
+    /*
+        Counts the lines from countedFrom to a position, so the position
+        of an error is known after the bytes before it are gone
+        Input: End of the bytes to count
+        Output: Updated line and column counts
+    */
+    void countLines(const char* position);
+
+    /*
+        Parses a part of a document pushed by feed(), which ends just before
+        a '<', so that its tokens are whole, in a comment or CDATA, or in a
+        processing instruction that is left for the next part. The part of a
+        comment or CDATA cut by a block ends at its "-->" or "]]>", or at the
+        end of the block
+        Input: The part, and if it is the last one of the document
+        Output: Number of bytes at the end of the part left for the next one
+    */
+    std::size_t parsePart(std::string_view part, bool lastPart);
+
+    /*
+        Performs the main parsing loop
+        For a handler with pullsEvents, returns after each token,
+        and the next call resumes after it
+        Input: N/A
+        Output: N/A
+    */
+    void parseDocument();
+
+    Handler& handler;
+    std::string inTagQName;
+    std::string_view inTagPrefix;
+    std::string_view inTagLocalName;
+    bool inTag = false;
+    bool inXMLComment = false;
+    bool inCDATA = false;
+    bool skipRequested = false;
+    bool emptyElement = false;
+    SkipState skipState;
+    bool skipping = false;
+    XMLParserError parseError;
+    XMLParserError unterminatedMarkup;
+    const char* countedFrom = nullptr;
+    std::int64_t lineCount = 0;
+    std::int64_t columnCount = 0;
+    std::int64_t totalBytes = 0;
+    std::string buffer;
+    char* bufferData = nullptr;
+    std::size_t bufferSize = 0;
+    std::string_view document;
+    bool inMemory = false;
+    int depth = 0;
+    int minimumDepth = 0;
+    const char* resumeCursor = nullptr;
+    const char* resumeCursorEnd = nullptr;
+    std::string feedTail;
+    bool feeding = false;
+    bool partialDocument = false;
+    bool continuedDocument = false;
+    std::size_t unparsedBytes = 0;
+    XMLParserInput* input = nullptr;
+
+public:
+    /*
+        Default Constructor
+        Input: Handler object and input buffer as std::string
+        Output: Initialized data members
+    */
+    BasicXMLParser(Handler &inputHandler, const std::string &inputBuffer);
+
+    /*
+        Constructor that takes ownership of the input buffer, with no copy
+        Input: Handler object and input buffer as std::string by move
+        Output: Initialized data members
+    */
+    BasicXMLParser(Handler &inputHandler, std::string &&inputBuffer);
+
+    /*
+        Constructor for a caller-owned buffer, e.g., a pinned or huge page
+        buffer reused across many parses with no allocation or initialization
+        The buffer is not copied, and must outlive the parse
+        Input: Handler object, start of the buffer, and its size
+        Output: Initialized data members
+    */
+    BasicXMLParser(Handler &inputHandler, char* inputBuffer, int inputSize);
+
+    /*
+        Constructor for a document already in memory, e.g., a MappedFile,
+        or for a fragment of one that starts at the given depth
+        The document is parsed in place, with no buffer refill or copy,
+        and must be followed by a readable byte for lookahead
+        Input: Handler object, the document, and its starting depth
+        Output: Initialized data members
+    */
+    BasicXMLParser(Handler &inputHandler, std::string_view inputDocument, int inputDepth = 0);
+
+    /*
+        Constructor for a pluggable input source, e.g., ReadAheadInput
+        The input source owns the buffers the document is parsed in
+        Input: Handler object and XMLParserInput object
+        Output: Initialized data members
+    */
+    BasicXMLParser(Handler &inputHandler, XMLParserInput &inputSource);
+
+    /*
+        Virtual default destructor
+        Input: N/A
+        Output: N/A
+    */
+    virtual ~BasicXMLParser() = default;
+
+    /*
+        Returns the total number of bytes read by the parser
+        Input: N/A
+        Output: Total bytes read as a 64-bit integer
+    */
+    std::int64_t getTotalBytes();
+
+    /*
+        Returns the depth of the parser, e.g., at the end of a fragment
+        Input: N/A
+        Output: Depth as int
+    */
+    int getDepth();
+
+    /*
+        Returns the lowest depth the parser reached, e.g., in a fragment
+        that closes elements started before it
+        Input: N/A
+        Output: Minimum depth as int
+    */
+    int getMinimumDepth();
+
+    /*
+        Returns if the parser stopped inside of markup, i.e.,
+        a start tag, an XML comment, or CDATA, e.g., at the end
+        of a fragment that was cut in the middle of a comment
+        Input: N/A
+        Output: Bool value for if the parser is inside of markup
+    */
+    bool isInMarkup();
+
+    /*
+        Skips the rest of the element of the last start tag, i.e., its
+        attributes, content, and end tag, with no events for any of it
+        Called from handleElementStartTag, or for a handler with
+        pullsEvents, after its start tag or one of its attributes
+        Input: N/A
+        Output: N/A
+    */
+    void skipElement();
+
+    /*
+        Parses the document, or for a handler with pullsEvents, the next
+        token, with no exit on a malformed document
+        Input: N/A
+        Output: Error that stopped the parse, with its position, or NONE
+    */
+    XMLParserError parse();
+
+    /*
+        Resets the parser to the start of a new document, with the same
+        handler and buffer, so a parser can be kept for many documents
+        instead of constructing one for each
+        Input: N/A
+        Output: Parse state of a new parser
+    */
+    void reset();
+
+    /*
+        Resets the parser, and parses a document already in memory, or a
+        fragment of one that starts at the given depth, as for the constructor
+        Input: The document, and its starting depth
+        Output: Error that stopped the parse, with its position, or NONE
+    */
+    XMLParserError parse(std::string_view inputDocument, int inputDepth = 0);
+
+    /*
+        Resets the parser, and parses the document of an input source,
+        as for the constructor
+        Input: XMLParserInput object
+        Output: Error that stopped the parse, with its position, or NONE
+    */
+    XMLParserError parse(XMLParserInput &inputSource);
+
+    /*
+        Parses the next block of a document pushed by the caller, e.g.,
+        from a socket or a decompressor, with no read of its own
+        The block is parsed in place, and only a token cut at its end
+        is copied, to be parsed with the next block, so the block can
+        be reused after the call. The first block starts a new document
+        Not for a handler with pullsEvents
+        Input: Start of the block and its size
+        Output: Error that stopped the parse, with its position, or NONE
+    */
+    XMLParserError feed(const char* data, std::size_t size);
+
+    /*
+        Ends a document pushed by feed(), and parses the rest of it
+        Input: N/A
+        Output: Error that stopped the parse, with its position, or NONE
+    */
+    XMLParserError finish();
+
+    /*
+        Returns the error that stopped the parse
+        Input: N/A
+        Output: Error with its position, or NONE
+    */
+    const XMLParserError& getError();
+};
+
+/*
+    Traces the start of an XML document
+    Input: N/A
+    Output: Trace
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::beginParsing(){
+    TRACE("START DOCUMENT");
+
+    return;
+}
+
+/*
+    Traces the end of an XML document
+    Input: N/A
+    Output: Trace
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::endParsing(){
+    TRACE("END DOCUMENT");
+
+    return;
+}
+
+/*
+    Returns if the parser is inside a namespace
+    Input: Start iterator of segment to parse
+    Output: Bool value for if the iterator is inside a namespace
+*/
+template <class Handler>
+bool BasicXMLParser<Handler>::isNamespace(const char* &cursor){
+    return (BasicXMLParser::inTag && (strncmp(std::addressof(*cursor), "xmlns", 5) == 0) && (cursor[5] == ':' || cursor[5] == '='));
+}
+
+/*
+    Returns if the parser is inside an XML comment
+    AND is NOT inside a namespace OR attribute
+    Input: Start iterator of segment to parse
+    Output: Bool value for if the iterator is inside an XML comment
+*/
+template <class Handler>
+bool BasicXMLParser<Handler>::isXMLComment(const char* &cursor){
+    return (BasicXMLParser::inXMLComment || (cursor[1] == '!' && *cursor == '<' && cursor[2] == '-' && cursor[3] == '-'));
+}
+
+/*
+    Returns if the parser is inside CDATA
+    AND is NOT inside a namespace, attribute, OR XML comment
+    Input: Start iterator of segment to parse
+    Output: Bool value for if the iterator is inside CDATA
+*/
+template <class Handler>
+bool BasicXMLParser<Handler>::isCDATA(const char* &cursor){
+    return (BasicXMLParser::inCDATA || (cursor[1] == '!' && *cursor == '<' && cursor[2] == '[' && (strncmp(std::addressof(cursor[3]), "CDATA[", 6) == 0)));
+}
+
+/*
+    Returns if the parser is inside an XML declaration
+    AND is NOT inside a namespace, attribute, XML comment, OR CDATA
+    Input: Start iterator of segment to parse
+    Output: Bool value for if the iterator is inside an XML declaration
+*/
+template <class Handler>
+bool BasicXMLParser<Handler>::isXMLDecl(const char* &cursor){
+    return (cursor[1] == '?' && *cursor == '<' && (strncmp(std::addressof(*cursor), "<?xml ", 6) == 0));
+}
+
+/*
+    Parses an xml namespace
+    Input: Start and end iterators of segment to parse; depth; and prefix and uri variables by ref
+    Output: Parsed prefix and uri by ref; adjusted depth value by ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseNamespace(const char* &cursor, const char* &cursorEnd, int &depth, std::string_view &prefix, std::string_view &uri){
+    std::advance(cursor, 5);
+    const auto nameEnd = std::find(cursor, cursorEnd, '=');
+    if (nameEnd == cursorEnd) {
+        error(XMLParserError::INCOMPLETE_NAMESPACE, cursor, cursorEnd);
+    }
+    int prefixSize = 0;
+    if (*cursor == ':') {
+        std::advance(cursor, 1);
+        prefixSize = std::distance(cursor, nameEnd);
+    }
+    const std::string_view prefixTemp(std::addressof(*cursor), prefixSize);
+    prefix = prefixTemp;
+    cursor = std::next(nameEnd);
+    cursor = std::find_if_not(cursor, cursorEnd, isspace);
+    if (cursor == cursorEnd) {
+        error(XMLParserError::INCOMPLETE_NAMESPACE, cursor, cursorEnd);
+    }
+    const char delimiter = *cursor;
+    if (delimiter != '"' && delimiter != '\'') {
+        error(XMLParserError::INCOMPLETE_NAMESPACE, cursor, cursorEnd);
+    }
+    std::advance(cursor, 1);
+    const auto valueEnd = std::find(cursor, cursorEnd, delimiter);
+    if (valueEnd == cursorEnd) {
+        error(XMLParserError::INCOMPLETE_NAMESPACE, cursor, cursorEnd);
+    }
+    const std::string_view uriTemp(std::addressof(*cursor), std::distance(cursor, valueEnd));
+    uri = uriTemp;
+    cursor = std::next(valueEnd);
+    cursor = std::find_if_not(cursor, cursorEnd, isspace);
+    TRACE("NAMESPACE", "prefix", prefix, "uri", uri);
+    if (*cursor == '>') {
+        std::advance(cursor, 1);
+        BasicXMLParser::inTag = false;
+        ++depth;
+    } else if (*cursor == '/' && cursor[1] == '>') {
+        std::advance(cursor, 2);
+        TRACE("END TAG", "prefix", BasicXMLParser::inTagPrefix, "qName", BasicXMLParser::inTagQName, "localName", BasicXMLParser::inTagLocalName);
+        BasicXMLParser::inTag = false;
+        if constexpr (pullsEvents)
+            BasicXMLParser::emptyElement = true;
+    }
+
+    return;
+}
+
+/*
+    Parses an xml attribute
+    Input: Start and end iterators of segment to parse; depth; and qName, prefix, localName, and value variables by ref
+    Output: qName, prefix, localName, and value by ref; adjusted depth value by ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseAttribute(const char* &cursor, const char* &cursorEnd, int &depth, std::string_view &qName, std::string_view &prefix, std::string_view &localName, std::string_view &value){
+    auto nameEnd = scanName(cursor, cursorEnd);
+    if (nameEnd != cursorEnd && *nameEnd == ':')
+        nameEnd = scanName(std::next(nameEnd), cursorEnd);
+    if (nameEnd == cursorEnd) {
+        error(XMLParserError::EMPTY_ATTRIBUTE_NAME, cursor, cursorEnd);
+    }
+    const std::string_view qNameTemp(std::addressof(*cursor), std::distance(cursor, nameEnd));
+    qName = qNameTemp;
+    size_t colonPosition = qNameTemp.find(':');
+    if (colonPosition == 0) {
+        error(XMLParserError::INVALID_ATTRIBUTE_NAME, cursor, cursorEnd);
+    }
+    if (colonPosition == std::string::npos)
+        colonPosition = 0;
+    const std::string_view prefixTemp(std::addressof(*qNameTemp.cbegin()), colonPosition);
+    prefix = prefixTemp;
+    if (colonPosition != 0)
+        colonPosition += 1;
+    const std::string_view localNameTemp(std::addressof(*qNameTemp.cbegin()) + colonPosition, qNameTemp.size() - colonPosition);
+    localName = localNameTemp;
+    cursor = nameEnd;
+    if (isspace(*cursor))
+        cursor = std::find_if_not(cursor, cursorEnd, isspace);
+    if (cursor == cursorEnd) {
+        error(XMLParserError::INCOMPLETE_ATTRIBUTE, cursor, cursorEnd);
+    }
+    if (*cursor != '=') {
+        error(XMLParserError::MISSING_ATTRIBUTE_EQUALS, cursor, cursorEnd);
+    }
+    std::advance(cursor, 1);
+    if (isspace(*cursor))
+        cursor = std::find_if_not(cursor, cursorEnd, isspace);
+    const char delimiter = *cursor;
+    if (delimiter != '"' && delimiter != '\'') {
+        error(XMLParserError::MISSING_ATTRIBUTE_DELIMITER, cursor, cursorEnd);
+    }
+    std::advance(cursor, 1);
+    auto valueEnd = std::find(cursor, cursorEnd, delimiter);
+    if (valueEnd == cursorEnd) {
+        error(XMLParserError::MISSING_ATTRIBUTE_DELIMITER, cursor, cursorEnd);
+    }
+    const std::string_view valueTemp(std::addressof(*cursor), std::distance(cursor, valueEnd));
+    value = valueTemp;
+    cursor = std::next(valueEnd);
+    TRACE("ATTRIBUTE", "prefix", prefix, "qname", qName, "localName", localName, "value", value);
+    if (isspace(*cursor))
+        cursor = std::find_if_not(std::next(cursor), cursorEnd, isspace);
+    if (*cursor == '>') {
+        std::advance(cursor, 1);
+        BasicXMLParser::inTag = false;
+        ++depth;
+    } else if (*cursor == '/' && cursor[1] == '>') {
+        std::advance(cursor, 2);
+        TRACE("END TAG", "prefix", BasicXMLParser::inTagPrefix, "qName", BasicXMLParser::inTagQName, "localName", BasicXMLParser::inTagLocalName);
+        BasicXMLParser::inTag = false;
+        if constexpr (pullsEvents)
+            BasicXMLParser::emptyElement = true;
+    }
+
+    return;
+}
+
+/*
+    Parses an xml comment
+    Input: Start and end iterators of segment to parse; comment variable by ref
+    Output: Parsed comment by ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseComment(const char* &cursor, const char* &cursorEnd, std::string_view &comment){
+    using namespace std::literals::string_view_literals;
+    if (cursor == cursorEnd) {
+        error(XMLParserError::UNTERMINATED_XML_COMMENT, cursor, cursorEnd);
+    }
+    const char* const commentStart = cursor;
+    const bool continued = BasicXMLParser::inXMLComment;
+    if (!continued)
+        std::advance(cursor, 4);
+    constexpr std::string_view endComment = "-->"sv;
+    auto tagEnd = std::search(cursor, cursorEnd, endComment.begin(), endComment.end());
+    BasicXMLParser::inXMLComment = tagEnd == cursorEnd;
+    if (BasicXMLParser::inXMLComment) {
+        // at the end of the document, the error is at the start of the comment
+        if (!continued)
+            BasicXMLParser::unterminatedMarkup = locateError(XMLParserError::UNTERMINATED_XML_COMMENT, commentStart, cursorEnd);
+        // a "-->" cut by the end of the buffer is found after the refill,
+        // so the piece before it may be empty, with no event
+        if (!BasicXMLParser::inMemory)
+            tagEnd = std::max(cursor, std::prev(tagEnd, endComment.size() - 1));
+    }
+    const std::string_view commentTemp(std::addressof(*cursor), std::distance(cursor, tagEnd));
+    comment = commentTemp;
+    if (!BasicXMLParser::inXMLComment)
+        cursor = std::next(tagEnd, endComment.size());
+    else{
+        cursor = tagEnd;
+    }
+    TRACE("COMMENT", "comment", comment);
+
+    return;
+}
+
+/*
+    Parses xml CDATA
+    Input: Start and end iterators of segment to parse; characters variable by ref
+    Output: Parsed characters by ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseCDATA(const char* &cursor, const char* &cursorEnd, std::string_view &characters){
+    using namespace std::literals::string_view_literals;
+    if (cursor == cursorEnd) {
+        error(XMLParserError::UNTERMINATED_CDATA, cursor, cursorEnd);
+    }
+    constexpr std::string_view endCDATA = "]]>"sv;
+    const char* const cdataStart = cursor;
+    const bool continued = BasicXMLParser::inCDATA;
+    if (!continued)
+        std::advance(cursor, 9);
+    auto tagEnd = std::search(cursor, cursorEnd, endCDATA.begin(), endCDATA.end());
+    BasicXMLParser::inCDATA = tagEnd == cursorEnd;
+    if (BasicXMLParser::inCDATA) {
+        // at the end of the document, the error is at the start of the CDATA
+        if (!continued)
+            BasicXMLParser::unterminatedMarkup = locateError(XMLParserError::UNTERMINATED_CDATA, cdataStart, cursorEnd);
+        // a "]]>" cut by the end of the buffer is found after the refill,
+        // so the piece before it may be empty, with no event
+        if (!BasicXMLParser::inMemory)
+            tagEnd = std::max(cursor, std::prev(tagEnd, endCDATA.size() - 1));
+    }
+    const std::string_view charactersTemp(std::addressof(*cursor), std::distance(cursor, tagEnd));
+    characters = charactersTemp;
+    if (!BasicXMLParser::inCDATA)
+        cursor = std::next(tagEnd, endCDATA.size());
+    else{
+        cursor = tagEnd;
+    }
+    TRACE("CDATA", "characters", characters);
+
+    return;
+}
+
+/*
+    Verifies the XML declaration is complete
+    Input: Start and end iterators of segment to parse; tagEnd
+    Output: If declaration is incomplete, outputs error message and exits
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::validateDeclaration(const char* &cursor, const char* &cursorEnd, const char* &tagEnd){
+    if ((tagEnd = std::find(cursor, cursorEnd, '>')) == cursorEnd) {
+        error(XMLParserError::INCOMPLETE_XML_DECLARATION, cursor, cursorEnd);
+    }
+
+    return;
+}
+
+/*
+    Parses xml declaration
+    Input: Start and end iterators of segment to parse; startXMLDecl, endXMLDecl, and tagEnd; version, encoding, and standalone variables by ref
+    Output: Parsed version, encoding, and standalone as ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseDeclaration(const char* &cursor, const char* &cursorEnd, std::string_view startXMLDecl, std::string_view endXMLDecl, const char* &tagEnd, std::string_view &version, std::optional<std::string_view> &encoding, std::optional<std::string_view> &standalone){
+    using namespace std::literals::string_view_literals;
+    std::advance(cursor, startXMLDecl.size());
+    cursor = std::find_if_not(cursor, tagEnd, isspace);
+
+    // parse required version
+    if (cursor == tagEnd) {
+        error(XMLParserError::INVALID_XML_DECLARATION, cursor, cursorEnd);
+    }
+    auto nameEnd = std::find(cursor, tagEnd, '=');
+    const std::string_view attr(std::addressof(*cursor), std::distance(cursor, nameEnd));
+    cursor = std::next(nameEnd);
+    const char delimiter = *cursor;
+    if (delimiter != '"' && delimiter != '\'') {
+        error(XMLParserError::INVALID_XML_DECLARATION, cursor, cursorEnd);
+    }
+    std::advance(cursor, 1);
+    auto valueEnd = std::find(cursor, tagEnd, delimiter);
+    if (valueEnd == tagEnd) {
+        error(XMLParserError::INVALID_XML_DECLARATION, cursor, cursorEnd);
+    }
+    if (attr != "version"sv) {
+        error(XMLParserError::INVALID_XML_DECLARATION, cursor, cursorEnd);
+    }
+    const std::string_view versionTemp(std::addressof(*cursor), std::distance(cursor, valueEnd));
+    version = versionTemp;
+    cursor = std::next(valueEnd);
+    cursor = std::find_if_not(cursor, tagEnd, isspace);
+
+    // parse optional encoding and standalone attributes
+    std::optional<std::string_view> encodingTemp;
+    std::optional<std::string_view> standaloneTemp;
+    if (cursor != (tagEnd - 1)) {
+        nameEnd = std::find(cursor, tagEnd, '=');
+        if (nameEnd == tagEnd) {
+            error(XMLParserError::INCOMPLETE_XML_DECLARATION, cursor, cursorEnd);
+        }
+        const std::string_view attr2(std::addressof(*cursor), std::distance(cursor, nameEnd));
+        cursor = std::next(nameEnd);
+        char delimiter2 = *cursor;
+        if (delimiter2 != '"' && delimiter2 != '\'') {
+            error(XMLParserError::INVALID_XML_DECLARATION, cursor, cursorEnd);
+        }
+        std::advance(cursor, 1);
+        valueEnd = std::find(cursor, tagEnd, delimiter2);
+        if (valueEnd == tagEnd) {
+            error(XMLParserError::INCOMPLETE_XML_DECLARATION, cursor, cursorEnd);
+        }
+        if (attr2 == "encoding"sv) {
+            encodingTemp = std::string_view(std::addressof(*cursor), std::distance(cursor, valueEnd));
+        } else if (attr2 == "standalone"sv) {
+            standaloneTemp = std::string_view(std::addressof(*cursor), std::distance(cursor, valueEnd));
+        } else {
+            error(XMLParserError::INVALID_XML_DECLARATION, cursor, cursorEnd);
+        }
+        cursor = std::next(valueEnd);
+        cursor = std::find_if_not(cursor, tagEnd, isspace);
+    }
+    if (cursor != (tagEnd - endXMLDecl.size() + 1)) {
+        nameEnd = std::find(cursor, tagEnd, '=');
+        if (nameEnd == tagEnd) {
+            error(XMLParserError::INCOMPLETE_XML_DECLARATION, cursor, cursorEnd);
+        }
+        const std::string_view attr2(std::addressof(*cursor), std::distance(cursor, nameEnd));
+        cursor = std::next(nameEnd);
+        const char delimiter2 = *cursor;
+        if (delimiter2 != '"' && delimiter2 != '\'') {
+            error(XMLParserError::INVALID_XML_DECLARATION, cursor, cursorEnd);
+        }
+        std::advance(cursor, 1);
+        valueEnd = std::find(cursor, tagEnd, delimiter2);
+        if (valueEnd == tagEnd) {
+            error(XMLParserError::INCOMPLETE_XML_DECLARATION, cursor, cursorEnd);
+        }
+        if (!standaloneTemp && attr2 == "standalone"sv) {
+            standaloneTemp = std::string_view(std::addressof(*cursor), std::distance(cursor, valueEnd));
+        } else {
+            error(XMLParserError::INVALID_XML_DECLARATION, cursor, cursorEnd);
+        }
+        cursor = std::next(valueEnd);
+        cursor = std::find_if_not(cursor, tagEnd, isspace);
+    }
+    encoding = encodingTemp;
+    standalone = standaloneTemp;
+    std::advance(cursor, endXMLDecl.size());
+    cursor = std::find_if_not(cursor, cursorEnd, isspace);
+    TRACE("XML DECLARATION", "version", version, "encoding", (encoding ? *encoding : ""), "standalone", (standalone ? *standalone : ""));
+
+    return;
+}
+
+/*
+    Verifies the processing instruction is complete 
+    Input: Start and end iterators of segment to parse; tagEnd, endPI
+    Output: If instruction is incomplete, outputs error message and exits
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::validateProcessInstruction(const char* &cursor, const char* &cursorEnd, const char* &tagEnd, std::string_view endPI){
+    if ((tagEnd = std::search(cursor, cursorEnd, endPI.begin(), endPI.end())) == cursorEnd) {
+        error(XMLParserError::INCOMPLETE_PROCESSING_INSTRUCTION, cursor, cursorEnd);
+    }
+
+    return;
+}
+
+/*
+    Parses xml processing instruction
+    Input: Start and end iterators of segment to parse; tagEnd; target and data variables by ref
+    Output: Parsed target and data as ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseProcessInstruction(const char* &cursor, const char* &cursorEnd, const char* &tagEnd, std::string_view &target, std::string_view &data){
+    std::advance(cursor, 2);
+    auto nameEnd = scanName(cursor, tagEnd);
+    if (nameEnd == tagEnd) {
+        error(XMLParserError::UNTERMINATED_PROCESSING_INSTRUCTION, cursor, cursorEnd);
+    }
+    const std::string_view targetTemp(std::addressof(*cursor), std::distance(cursor, nameEnd));
+    target = targetTemp;
+    cursor = std::find_if_not(nameEnd, tagEnd, isspace);
+    const std::string_view dataTemp(std::addressof(*cursor), std::distance(cursor, tagEnd));
+    data = dataTemp;
+    cursor = tagEnd;
+    std::advance(cursor, 2);
+    TRACE("PI", "target", target, "data", data);
+
+    return;
+}
+
+/*
+    Verifies the element end tag is complete
+    Input: Start and end iterators of segment to parse; tagEnd
+    Output: If element end tag is incomplete, outputs error message and exits
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::validateEndTag(const char* &cursor, const char* &cursorEnd, const char* &tagEnd){
+    if ((tagEnd = std::find(cursor, cursorEnd, '>')) == cursorEnd) {
+        error(XMLParserError::INCOMPLETE_END_TAG, cursor, cursorEnd);
+    }
+
+    return;
+}
+
+/*
+    Parses xml end tag
+    Input: Start and end iterators of segment to parse; depth; prefix, qName, and localName variables by ref
+    Output: Parsed prefix, qName, and localName as ref; adjusted depth value by ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseEndTag(const char* &cursor, const char* &cursorEnd, int &depth, std::string_view &prefix, std::string_view &qName, std::string_view &localName){
+    std::advance(cursor, 2);
+    if (*cursor == ':') {
+        error(XMLParserError::INVALID_END_TAG_NAME, cursor, cursorEnd);
+    }
+    auto nameEnd = scanName(cursor, cursorEnd);
+    if (nameEnd == cursorEnd) {
+        error(XMLParserError::UNTERMINATED_END_TAG, cursor, cursorEnd);
+    }
+    size_t colonPosition = 0;
+    if (*nameEnd == ':') {
+        colonPosition = std::distance(cursor, nameEnd);
+        nameEnd = scanName(std::next(nameEnd), cursorEnd);
+    }
+    const std::string_view prefixTemp(std::addressof(*cursor), colonPosition);
+    prefix = prefixTemp;
+    const std::string_view qNameTemp(std::addressof(*cursor), std::distance(cursor, nameEnd));
+    qName = qNameTemp;
+    if (qNameTemp.empty()) {
+        error(XMLParserError::INVALID_END_TAG_NAME, cursor, cursorEnd);
+    }
+    if (colonPosition)
+        ++colonPosition;
+    const std::string_view localNameTemp(std::addressof(*cursor) + colonPosition, std::distance(cursor, nameEnd) - colonPosition);
+    localName = localNameTemp;
+    cursor = std::next(nameEnd);
+    --depth;
+    TRACE("END TAG", "prefix", prefix, "qName", qName, "localName", localName);
+
+    return;
+}
+
+/*
+    Verifies the element start tag is complete
+    Input: Start and end iterators of segment to parse; tagEnd
+    Output: If element start tag is incomplete, outputs error message and exits
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::validateStartTag(const char* &cursor, const char* &cursorEnd, const char* &tagEnd){
+    if ((tagEnd = std::find(cursor, cursorEnd, '>')) == cursorEnd) {
+        error(XMLParserError::INCOMPLETE_START_TAG, cursor, cursorEnd);
+    }
+
+    return;
+}
+
+/*
+    Parses xml start tag
+    Input: Start and end iterators of segment to parse; prefix, qName, and localName variables by ref
+    Output: Parsed prefix, qName, and localName as ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseStartTag(const char* &cursor, const char* &cursorEnd, std::string_view &prefix, std::string_view &qName, std::string_view &localName){
+    std::advance(cursor, 1);
+    if (*cursor == ':') {
+        error(XMLParserError::INVALID_START_TAG_NAME, cursor, cursorEnd);
+    }
+    auto nameEnd = scanName(cursor, cursorEnd);
+    if (nameEnd == cursorEnd) {
+        error(XMLParserError::UNTERMINATED_START_TAG, cursor, cursorEnd);
+    }
+    size_t colonPosition = 0;
+    if (*nameEnd == ':') {
+        colonPosition = std::distance(cursor, nameEnd);
+        nameEnd = scanName(std::next(nameEnd), cursorEnd);
+    }
+    const std::string_view prefixTemp(std::addressof(*cursor), colonPosition);
+    prefix = prefixTemp;
+    const std::string_view qNameTemp(std::addressof(*cursor), std::distance(cursor, nameEnd));
+    qName = qNameTemp;
+    if (qName.empty()) {
+        error(XMLParserError::INVALID_START_TAG_NAME, cursor, cursorEnd);
+    }
+    if (colonPosition)
+        ++colonPosition;
+    const std::string_view localNameTemp(std::addressof(*cursor) + colonPosition, std::distance(cursor, nameEnd) - colonPosition);
+    localName = localNameTemp;
+    cursor = nameEnd;
+    TRACE("START TAG", "prefix", prefix, "qName", qName, "localName", localName);
+    if (*cursor != '>')
+        cursor = std::find_if_not(cursor, cursorEnd, isspace);
+    if (*cursor != '>' && (*cursor == '/' && cursor[1] == '>'))
+        TRACE("END TAG", "prefix", prefix, "qName", qName, "localName", localName);
+
+    if (*cursor != '>' && (*cursor != '/' || cursor[1] != '>')) {
+        BasicXMLParser::inTagQName = qName;
+        BasicXMLParser::inTagPrefix = std::string_view(qName.data(), prefix.size());
+        BasicXMLParser::inTagLocalName = localName;
+        BasicXMLParser::inTag = true;
+    }
+
+    return;
+}
+
+/*
+    Parses character entity references
+    Input: Start iterator of segment to parse; characters variable by ref
+    Output: Parsed characters as ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseCharEntity(const char* &cursor, std::string_view &characters){
+    if (cursor[1] == 'l' && cursor[2] == 't' && cursor[3] == ';') {
+        characters = "<";
+        std::advance(cursor, 4);
+    } else if (cursor[1] == 'g' && cursor[2] == 't' && cursor[3] == ';') {
+        characters = ">";
+        std::advance(cursor, 4);
+    } else if (cursor[1] == 'a' && cursor[2] == 'm' && cursor[3] == 'p' && cursor[4] == ';') {
+        characters = "&";
+        std::advance(cursor, 5);
+    } else {
+        characters = "&";
+        std::advance(cursor, 1);
+    }
+    TRACE("ENTITYREF", "characters", characters);
+
+    return;
+}
+
+/*
+    Parses character non-entity references
+    Input: Start and end iterators of segment to parse; characters and newlineCount variables by ref
+    Output: Parsed characters and their number of newlines as ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseCharNonEntity(const char* &cursor, const char* &cursorEnd, std::string_view &characters, int &newlineCount){
+    const auto tagEnd = scanCharacters(cursor, cursorEnd, newlineCount);
+    const std::string_view charactersTemp(std::addressof(*cursor), std::distance(cursor, tagEnd));
+    characters = charactersTemp;
+    std::advance(cursor, characters.size());
+    TRACE("CHARACTERS", "characters", characters);
+
+    return;
+}
+
+/*
+    Refills the buffer from the input source or standard input, or
+    reports the end of input for a document that is already in memory
+    Input: Start and end iterators of segment to parse
+    Output: Number of bytes read (0 at EOF, -1 on error); adjusted iterators by ref
+*/
+template <class Handler>
+int BasicXMLParser<Handler>::refill(const char* &cursor, const char* &cursorEnd){
+    if (BasicXMLParser::inMemory) {
+        // whole document is already in [cursor, cursorEnd), nothing more to read,
+        // and the cursor stays at the token that needed more, for its error
+        return 0;
+    }
+
+    // lines of the bytes the refill drops, for the position of an error
+    if (BasicXMLParser::countedFrom)
+        countLines(cursor);
+
+    int bytesRead = 0;
+    if (BasicXMLParser::input)
+        bytesRead = BasicXMLParser::input->refill(cursor, cursorEnd);
+    else if (BasicXMLParser::bufferData)
+        bytesRead = refillBuffer(cursor, cursorEnd, BasicXMLParser::bufferData, BasicXMLParser::bufferSize);
+    else
+        bytesRead = refillBuffer(cursor, cursorEnd, BasicXMLParser::buffer);
+    // at EOF the unprocessed bytes are left in place, to parse as a document in memory
+    if (bytesRead == 0)
+        BasicXMLParser::inMemory = true;
+    BasicXMLParser::countedFrom = cursor;
+
+    return bytesRead;
+}
+
+/*
+    Counts the lines from countedFrom to a position, so the position
+    of an error is known after the bytes before it are gone
+    Input: End of the bytes to count
+    Output: Updated line and column counts
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::countLines(const char* position){
+    // newlines counted in blocks that fit a byte counter, which the compiler vectorizes
+    for (const char* block = BasicXMLParser::countedFrom; block != position; ) {
+        const long blockSize = std::min(std::distance(block, position), 255L);
+        unsigned char newlines = 0;
+        for (long i = 0; i < blockSize; ++i)
+            newlines += block[i] == '\n';
+        BasicXMLParser::lineCount += newlines;
+        std::advance(block, blockSize);
+    }
+    const char* lastNewline = std::find(std::make_reverse_iterator(position), std::make_reverse_iterator(BasicXMLParser::countedFrom), '\n').base();
+    BasicXMLParser::columnCount = std::distance(lastNewline, position) + (lastNewline == BasicXMLParser::countedFrom ? BasicXMLParser::columnCount : 0);
+}
+
+/*
+    Default Constructor
+    Input: Handler object and input buffer as std::string
+    Output: Initialized data members
+*/
+template <class Handler>
+BasicXMLParser<Handler>::BasicXMLParser(Handler &inputHandler, const std::string &inputBuffer)
+    : handler(inputHandler), buffer(inputBuffer)
+{}
+
+/*
+    Constructor that takes ownership of the input buffer, with no copy
+    Input: Handler object and input buffer as std::string by move
+    Output: Initialized data members
+*/
+template <class Handler>
+BasicXMLParser<Handler>::BasicXMLParser(Handler &inputHandler, std::string &&inputBuffer)
+    : handler(inputHandler), buffer(std::move(inputBuffer))
+{}
+
+/*
+    Constructor for a caller-owned buffer, e.g., a pinned or huge page
+    buffer reused across many parses with no allocation or initialization
+    The buffer is not copied, and must outlive the parse
+    Input: Handler object, start of the buffer, and its size
+    Output: Initialized data members
+*/
+template <class Handler>
+BasicXMLParser<Handler>::BasicXMLParser(Handler &inputHandler, char* inputBuffer, int inputSize)
+    : handler(inputHandler), bufferData(inputBuffer), bufferSize(inputSize)
+{}
+
+/*
+    Constructor for a document already in memory, e.g., a MappedFile,
+    or for a fragment of one that starts at the given depth
+    The document is parsed in place, with no buffer refill or copy,
+    and must be followed by a readable byte for lookahead
+    Input: Handler object, the document, and its starting depth
+    Output: Initialized data members
+*/
+template <class Handler>
+BasicXMLParser<Handler>::BasicXMLParser(Handler &inputHandler, std::string_view inputDocument, int inputDepth)
+    : handler(inputHandler), document(inputDocument), inMemory(true), depth(inputDepth)
+{}
+
+/*
+    Constructor for a pluggable input source, e.g., ReadAheadInput
+    The input source owns the buffers the document is parsed in
+    Input: Handler object and XMLParserInput object
+    Output: Initialized data members
+*/
+template <class Handler>
+BasicXMLParser<Handler>::BasicXMLParser(Handler &inputHandler, XMLParserInput &inputSource)
+    : handler(inputHandler), input(&inputSource)
+{}
+
+/*
+    Returns the total number of bytes read by the parser
+    Input: N/A
+    Output: Total bytes read as a 64-bit integer
+*/
+template <class Handler>
+std::int64_t BasicXMLParser<Handler>::getTotalBytes(){
+    return BasicXMLParser::totalBytes;
+}
+
+/*
+    Returns the depth of the parser, e.g., at the end of a fragment
+    Input: N/A
+    Output: Depth as int
+*/
+template <class Handler>
+int BasicXMLParser<Handler>::getDepth(){
+    return BasicXMLParser::depth;
+}
+
+/*
+    Returns the lowest depth the parser reached, e.g., in a fragment
+    that closes elements started before it
+    Input: N/A
+    Output: Minimum depth as int
+*/
+template <class Handler>
+int BasicXMLParser<Handler>::getMinimumDepth(){
+    return BasicXMLParser::minimumDepth;
+}
+
+/*
+    Returns if the parser stopped inside of markup, i.e.,
+    a start tag, an XML comment, or CDATA, e.g., at the end
+    of a fragment that was cut in the middle of a comment
+    Input: N/A
+    Output: Bool value for if the parser is inside of markup
+*/
+template <class Handler>
+bool BasicXMLParser<Handler>::isInMarkup(){
+    return BasicXMLParser::inTag || BasicXMLParser::inXMLComment || BasicXMLParser::inCDATA;
+}
+
+/*
+    Skips the rest of the element of the last start tag, i.e., its
+    attributes, content, and end tag, with no events for any of it
+    Called from handleElementStartTag, or for a handler with
+    pullsEvents, after its start tag or one of its attributes
+    Input: N/A
+    Output: N/A
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::skipElement(){
+    BasicXMLParser::skipRequested = true;
+}
+
+/*
+    Skips the rest of an element without events, from inside its start
+    tag, or from its content, up to and including its end tag
+    Input: Start and end iterators of segment to parse; whether the cursor is in the start tag
+    Output: Adjusted iterators by ref
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::skipElementContent(const char* &cursor, const char* &cursorEnd, bool inStartTag){
+    // only the markup is looked at, with the rest of the element skipped by
+    // skipMarkup, which stops where it needs more of the buffer to continue,
+    // or for a skip that continues from the last part of a fed document
+    SkipState& state = BasicXMLParser::skipState;
+    if (!BasicXMLParser::skipping) {
+        state = SkipState();
+        if (inStartTag) {
+            state.mode = SkipState::START_TAG;
+            state.level = 0;
+        }
+    }
+    BasicXMLParser::skipping = false;
+    while (true) {
+        cursor = skipMarkup(cursor, cursorEnd, state);
+        if (state.level == 0 && state.mode == SkipState::CONTENT)
+            return;
+        if (state.mode == SkipState::INVALID) {
+            error(XMLParserError::INVALID_START_TAG_NAME, cursor, cursorEnd);
+        }
+
+        // the skip continues in the next part of a fed document, with the bytes left in this one
+        if (BasicXMLParser::partialDocument) {
+            BasicXMLParser::skipping = true;
+            BasicXMLParser::unparsedBytes = std::distance(cursor, cursorEnd);
+            cursor = cursorEnd;
+            return;
+        }
+
+        // more of the buffer, which an unterminated element does not have at the end of the input
+        const int bytesRead = BasicXMLParser::inMemory ? 0 : refill(cursor, cursorEnd);
+        if (bytesRead < 0) {
+            error(XMLParserError::INPUT_ERROR, cursor, cursorEnd);
+        }
+        if (bytesRead == 0) {
+            error(XMLParserError::UNTERMINATED_ELEMENT, cursor, cursorEnd);
+        }
+        BasicXMLParser::totalBytes += bytesRead;
+    }
+}
+
+/*
+    Stops the parse at a malformed construct, or an input error, which
+    parse() returns with its position. Never returns, so the compiler
+    keeps the error paths out of the way of the success path
+    Input: Error code, position of the error, and end of the buffer
+    Output: N/A
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::error(XMLParserError::Code code, const char* position, const char* cursorEnd){
+    throw locateError(code, position, cursorEnd);
+}
+
+/*
+    Finds the position of an error in the document, e.g., of the start
+    of a comment that may be unterminated, while its bytes are in the buffer
+    Input: Error code, position of the error, and end of the buffer
+    Output: Error with its position
+*/
+template <class Handler>
+XMLParserError BasicXMLParser<Handler>::locateError(XMLParserError::Code code, const char* position, const char* cursorEnd){
+    XMLParserError parseError;
+    parseError.code = code;
+    if (code == XMLParserError::INPUT_ERROR && BasicXMLParser::input)
+        parseError.detail = BasicXMLParser::input->errorMessage();
+    if (BasicXMLParser::inMemory && !BasicXMLParser::countedFrom) {
+        parseError.locate(BasicXMLParser::document, std::distance(BasicXMLParser::document.data(), position));
+    } else {
+        // lines of the buffer since the last refill, or of the part since the
+        // last part of a fed document, after the lines before it
+        parseError.offset = BasicXMLParser::totalBytes - std::distance(position, cursorEnd);
+        const char* lineStart = BasicXMLParser::countedFrom ? BasicXMLParser::countedFrom : position;
+        parseError.line = BasicXMLParser::lineCount + std::count(lineStart, position, '\n') + 1;
+        const char* lastNewline = std::find(std::make_reverse_iterator(position), std::make_reverse_iterator(lineStart), '\n').base();
+        parseError.column = std::distance(lastNewline, position) + (lastNewline == lineStart ? BasicXMLParser::columnCount : 0) + 1;
+    }
+
+    return parseError;
+}
+
+/*
+    Parses the document, or for a handler with pullsEvents, the next
+    token, with no exit on a malformed document
+    Input: N/A
+    Output: Error that stopped the parse, with its position, or NONE
+*/
+template <class Handler>
+XMLParserError BasicXMLParser<Handler>::parse(){
+
+    // a parse stopped by an error does not continue
+    if (BasicXMLParser::parseError)
+        return BasicXMLParser::parseError;
+
+    try {
+        parseDocument();
+    } catch (const XMLParserError& stopped) {
+        BasicXMLParser::parseError = stopped;
+    }
+
+    return BasicXMLParser::parseError;
+}
+
+/*
+    Resets the parser to the start of a new document, with the same
+    handler and buffer, so a parser can be kept for many documents
+    instead of constructing one for each
+    Input: N/A
+    Output: Parse state of a new parser
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::reset(){
+    BasicXMLParser::inTagQName.clear();
+    BasicXMLParser::inTag = false;
+    BasicXMLParser::inXMLComment = false;
+    BasicXMLParser::inCDATA = false;
+    BasicXMLParser::skipRequested = false;
+    BasicXMLParser::emptyElement = false;
+    BasicXMLParser::skipping = false;
+    BasicXMLParser::parseError = XMLParserError();
+    BasicXMLParser::unterminatedMarkup = XMLParserError();
+    BasicXMLParser::countedFrom = nullptr;
+    BasicXMLParser::lineCount = 0;
+    BasicXMLParser::columnCount = 0;
+    BasicXMLParser::totalBytes = 0;
+    BasicXMLParser::depth = 0;
+    BasicXMLParser::minimumDepth = 0;
+    BasicXMLParser::resumeCursor = nullptr;
+    BasicXMLParser::resumeCursorEnd = nullptr;
+    BasicXMLParser::feedTail.clear();
+    BasicXMLParser::feeding = false;
+    BasicXMLParser::partialDocument = false;
+    BasicXMLParser::continuedDocument = false;
+}
+
+/*
+    Resets the parser, and parses a document already in memory, or a
+    fragment of one that starts at the given depth, as for the constructor
+    Input: The document, and its starting depth
+    Output: Error that stopped the parse, with its position, or NONE
+*/
+template <class Handler>
+XMLParserError BasicXMLParser<Handler>::parse(std::string_view inputDocument, int inputDepth){
+    reset();
+    BasicXMLParser::document = inputDocument;
+    BasicXMLParser::inMemory = true;
+    BasicXMLParser::input = nullptr;
+    BasicXMLParser::depth = inputDepth;
+
+    return parse();
+}
+
+/*
+    Resets the parser, and parses the document of an input source,
+    as for the constructor
+    Input: XMLParserInput object
+    Output: Error that stopped the parse, with its position, or NONE
+*/
+template <class Handler>
+XMLParserError BasicXMLParser<Handler>::parse(XMLParserInput &inputSource){
+    reset();
+    BasicXMLParser::document = std::string_view();
+    BasicXMLParser::inMemory = false;
+    BasicXMLParser::input = &inputSource;
+
+    return parse();
+}
+
+/*
+    Parses a part of a document pushed by feed(), which ends just before
+    a '<', so that its tokens are whole, in a comment or CDATA, or in a
+    processing instruction that is left for the next part. The part of a
+    comment or CDATA cut by a block ends at its "-->" or "]]>", or at the
+    end of the block
+    Input: The part, and if it is the last one of the document
+    Output: Number of bytes at the end of the part left for the next one
+*/
+template <class Handler>
+std::size_t BasicXMLParser<Handler>::parsePart(std::string_view part, bool lastPart){
+    BasicXMLParser::document = part;
+    BasicXMLParser::inMemory = true;
+    BasicXMLParser::input = nullptr;
+    BasicXMLParser::partialDocument = !lastPart;
+    BasicXMLParser::unparsedBytes = 0;
+    BasicXMLParser::countedFrom = part.data();
+    parse();
+    BasicXMLParser::continuedDocument = true;
+
+    // bytes left by a skip, or of a processing instruction, are parsed again,
+    // and counted, with the next part
+    BasicXMLParser::totalBytes -= BasicXMLParser::unparsedBytes;
+    countLines(part.data() + part.size() - BasicXMLParser::unparsedBytes);
+
+    return BasicXMLParser::unparsedBytes;
+}
+
+/*
+    Parses the next block of a document pushed by the caller, e.g.,
+    from a socket or a decompressor, with no read of its own
+    The block is parsed in place, and only a token cut at its end
+    is copied, to be parsed with the next block, so the block can
+    be reused after the call. The first block starts a new document
+    Not for a handler with pullsEvents
+    Input: Start of the block and its size
+    Output: Error that stopped the parse, with its position, or NONE
+*/
+template <class Handler>
+XMLParserError BasicXMLParser<Handler>::feed(const char* data, std::size_t size){
+    if (!BasicXMLParser::feeding) {
+        reset();
+        BasicXMLParser::feeding = true;
+    }
+    if (BasicXMLParser::parseError)
+        return BasicXMLParser::parseError;
+
+    // the token cut at the end of the last block is whole up to the next '<',
+    // and is parsed on its own, with any bytes a skip left before it
+    std::string& tail = BasicXMLParser::feedTail;
+    const char* cursor = data;
+    const char* const dataEnd = data + size;
+    const char* from = data;
+    while (!tail.empty()) {
+        if (BasicXMLParser::inXMLComment || BasicXMLParser::inCDATA) {
+            // a comment or CDATA cut at the end of the last block is whole up to
+            // its "-->" or "]]>", which may start in the tail, as a '<' in it starts no token
+            using namespace std::literals::string_view_literals;
+            const std::string_view terminator = BasicXMLParser::inXMLComment ? "-->"sv : "]]>"sv;
+            const std::size_t kept = tail.size();
+            tail.append(cursor, std::next(cursor, std::min<std::ptrdiff_t>(terminator.size() - 1, std::distance(cursor, dataEnd))));
+            std::size_t partSize = tail.find(terminator);
+            if (partSize != std::string::npos) {
+                partSize += terminator.size();
+                if (partSize > kept) {
+                    std::advance(cursor, partSize - kept);
+                    tail.resize(partSize);
+                } else {
+                    tail.resize(kept);
+                }
+            } else {
+                tail.resize(kept);
+                const char* const end = std::search(cursor, dataEnd, terminator.begin(), terminator.end());
+                if (end == dataEnd) {
+                    // the piece in this block is parsed, except for bytes that may start the end
+                    tail.append(cursor, dataEnd);
+                    if (tail.size() < terminator.size())
+                        return BasicXMLParser::parseError;
+                    partSize = tail.size() - (terminator.size() - 1);
+                    const std::size_t unparsed = parsePart(std::string_view(tail.data(), partSize), false);
+                    tail.erase(0, partSize - unparsed);
+                    return BasicXMLParser::parseError;
+                }
+                tail.append(cursor, std::next(end, terminator.size()));
+                cursor = std::next(end, terminator.size());
+                partSize = tail.size();
+            }
+            const std::size_t unparsed = parsePart(std::string_view(tail.data(), partSize), false);
+            tail.erase(0, partSize - unparsed);
+            if (BasicXMLParser::parseError)
+                return BasicXMLParser::parseError;
+            from = cursor;
+            continue;
+        }
+        const char* const next = static_cast<const char*>(std::memchr(from, '<', std::distance(from, dataEnd)));
+        if (next == nullptr) {
+            tail.append(cursor, dataEnd);
+            return BasicXMLParser::parseError;
+        }
+        tail.append(cursor, next);
+        cursor = next;
+        const std::size_t unparsed = parsePart(tail, false);
+        tail.erase(0, tail.size() - unparsed);
+        if (BasicXMLParser::parseError)
+            return BasicXMLParser::parseError;
+        from = std::next(cursor);
+    }
+
+    // the rest is parsed in place up to its last '<', which starts a token that may be cut
+    const char* const partEnd = std::find(std::make_reverse_iterator(dataEnd), std::make_reverse_iterator(cursor), '<').base();
+    if (partEnd == cursor || std::prev(partEnd) == cursor) {
+        tail.assign(cursor, dataEnd);
+        return BasicXMLParser::parseError;
+    }
+    const std::size_t unparsed = parsePart(std::string_view(cursor, std::distance(cursor, std::prev(partEnd))), false);
+    tail.assign(std::prev(partEnd) - unparsed, dataEnd);
+
+    return BasicXMLParser::parseError;
+}
+
+/*
+    Ends a document pushed by feed(), and parses the rest of it
+    Input: N/A
+    Output: Error that stopped the parse, with its position, or NONE
+*/
+template <class Handler>
+XMLParserError BasicXMLParser<Handler>::finish(){
+    if (!BasicXMLParser::feeding)
+        reset();
+    BasicXMLParser::feeding = false;
+    if (!BasicXMLParser::parseError)
+        parsePart(BasicXMLParser::feedTail, true);
+    BasicXMLParser::feedTail.clear();
+
+    return BasicXMLParser::parseError;
+}
+
+/*
+    Returns the error that stopped the parse
+    Input: N/A
+    Output: Error with its position, or NONE
+*/
+template <class Handler>
+const XMLParserError& BasicXMLParser<Handler>::getError(){
+    return BasicXMLParser::parseError;
+}
+
+/*
+    Performs the main parsing loop
+    For a handler with pullsEvents, returns after each token,
+    and the next call resumes after it
+    Input: N/A
+    Output: N/A
+*/
+template <class Handler>
+void BasicXMLParser<Handler>::parseDocument(){
+    using namespace std::literals::string_view_literals;
+    int depth = BasicXMLParser::depth;
+    int minimumDepth = BasicXMLParser::continuedDocument ? BasicXMLParser::minimumDepth : depth;
+    const char* cursor = BasicXMLParser::bufferData ? BasicXMLParser::bufferData + BasicXMLParser::bufferSize
+                                                    : BasicXMLParser::buffer.data() + BasicXMLParser::buffer.size();
+    const char* cursorEnd = cursor;
+    bool resume = false;
+    if constexpr (pullsEvents)
+        resume = BasicXMLParser::resumeCursor != nullptr;
+    if (resume) {
+        // continue after the token of the last call
+        minimumDepth = BasicXMLParser::minimumDepth;
+        cursor = BasicXMLParser::resumeCursor;
+        cursorEnd = BasicXMLParser::resumeCursorEnd;
+
+        // skip the element of that token, from its start tag, or from its content
+        if (BasicXMLParser::skipRequested) {
+            BasicXMLParser::skipRequested = false;
+            if (BasicXMLParser::inTag) {
+                BasicXMLParser::inTag = false;
+                skipElementContent(cursor, cursorEnd, true);
+            } else if (!BasicXMLParser::emptyElement) {
+                skipElementContent(cursor, cursorEnd, false);
+                --depth;
+            }
+        }
+    } else if (BasicXMLParser::inMemory) {
+        cursor = BasicXMLParser::document.data();
+        cursorEnd = cursor + BasicXMLParser::document.size();
+        BasicXMLParser::totalBytes += BasicXMLParser::document.size();
+    }
+
+    // a buffer is refilled when less than the longest lookahead remains,
+    // while a document in memory is parsed to its last byte
+    long minimumBytes = BasicXMLParser::inMemory ? 1 : 5;
+
+    if (!resume && !BasicXMLParser::continuedDocument) {
+        beginParsing();
+        if constexpr ((eventMask & XMLParserHandler::START_DOCUMENT) != 0)
+            handler.handleStartDocument(depth);
+    }
+
+    // a skip cut at the end of the last part of a fed document continues in this one
+    if (BasicXMLParser::skipping)
+        skipElementContent(cursor, cursorEnd, true);
+
+    while (true) {
+
+        if (std::distance(cursor, cursorEnd) < minimumBytes) {
+            // refill buffer and adjust iterator
+            int bytesRead = refill(cursor, cursorEnd);
+            if (bytesRead < 0) {
+                error(XMLParserError::INPUT_ERROR, cursor, cursorEnd);
+            }
+            BasicXMLParser::totalBytes += bytesRead;
+            if (bytesRead == 0) {
+                // the bytes left after the last read are parsed to the last one
+                minimumBytes = 1;
+                if (cursor == cursorEnd)
+                    break;
+            }
+
+        } else if (BasicXMLParser::inTag | BasicXMLParser::inXMLComment | BasicXMLParser::inCDATA) {
+            // continue the start tag, XML comment, or CDATA the last token ended in
+            if (BasicXMLParser::inXMLComment) {
+                // parse XML comment
+                std::string_view comment(""sv);
+                parseComment(cursor, cursorEnd, comment);
+                if constexpr ((eventMask & XMLParserHandler::XML_COMMENT) != 0)
+                    if (!comment.empty() || !BasicXMLParser::inXMLComment)
+                        handler.handleXMLComment(comment, depth);
+
+            } else if (BasicXMLParser::inCDATA) {
+                // parse CDATA
+                std::string_view characters(""sv);
+                parseCDATA(cursor, cursorEnd, characters);
+                if constexpr ((eventMask & XMLParserHandler::CDATA) != 0)
+                    if (!characters.empty() || !BasicXMLParser::inCDATA)
+                        handler.handleCDATA(characters, depth);
+
+            } else if (isNamespace(cursor)) {
+                // parse XML namespace
+                std::string_view prefix(""sv);
+                std::string_view uri(""sv);
+                parseNamespace(cursor, cursorEnd, depth, prefix, uri);
+                if constexpr ((eventMask & XMLParserHandler::XML_NAMESPACE) != 0)
+                    handler.handleXMLNamespace(prefix, uri, depth);
+
+            } else {
+                // parse attribute
+                std::string_view qName(""sv);
+                std::string_view prefix(""sv);
+                std::string_view localName(""sv);
+                std::string_view value(""sv);
+                parseAttribute(cursor, cursorEnd, depth, qName, prefix, localName, value);
+                if constexpr ((eventMask & XMLParserHandler::ATTRIBUTE) != 0)
+                    handler.handleAttribute(qName, prefix, localName, value, depth);
+            }
+
+        } else if (*cursor != '<') {
+            // characters, decided by the first byte
+            if (depth == 0) {
+                // parse characters before or after XML, which are only whitespace
+                cursor = std::find_if_not(cursor, cursorEnd, isspace);
+                if (cursor != cursorEnd && *cursor != '<') {
+                    error(XMLParserError::CHARACTERS_OUTSIDE_ROOT, cursor, cursorEnd);
+                }
+
+            } else if ((eventMask & XMLParserHandler::CHARACTERS) == 0) {
+                // skip unhandled characters, with their entity references
+                cursor = static_cast<const char*>(std::memchr(std::next(cursor), '<', std::distance(std::next(cursor), cursorEnd)));
+                if (cursor == nullptr)
+                    cursor = cursorEnd;
+
+            } else if (*cursor == '&') {
+                // parse character entity references
+                std::string_view characters;
+                parseCharEntity(cursor, characters);
+                if constexpr ((eventMask & XMLParserHandler::CHARACTERS) != 0)
+                    handler.handleCharacters(characters, 0, depth);
+
+            } else {
+                // parse character non-entity references
+                std::string_view characters(""sv);
+                int newlineCount = 0;
+                parseCharNonEntity(cursor, cursorEnd, characters, newlineCount);
+                if constexpr ((eventMask & XMLParserHandler::CHARACTERS) != 0)
+                    handler.handleCharacters(characters, newlineCount, depth);
+            }
+
+        } else {
+            // markup, decided by the byte after the '<'
+            switch (cursor[1]) {
+            case '/': {
+                // parse end tag, with a refill when its '>' is cut by the end of the buffer
+                auto tagEnd = static_cast<const char*>(std::memchr(cursor, '>', std::distance(cursor, cursorEnd)));
+                if (tagEnd == nullptr) {
+                    int bytesRead = refill(cursor, cursorEnd);
+                    if (bytesRead < 0) {
+                        error(XMLParserError::INPUT_ERROR, cursor, cursorEnd);
+                    }
+                    BasicXMLParser::totalBytes += bytesRead;
+                    validateEndTag(cursor, cursorEnd, tagEnd);
+                }
+                if constexpr ((eventMask & XMLParserHandler::END_TAG) != 0) {
+                    std::string_view prefix(""sv);
+                    std::string_view qName(""sv);
+                    std::string_view localName(""sv);
+                    parseEndTag(cursor, cursorEnd, depth, prefix, qName, localName);
+                    if constexpr (internsNames)
+                        handler.handleElementEndTag(qName, prefix, localName, handler.elementNames.intern(qName), depth);
+                    else
+                        handler.handleElementEndTag(qName, prefix, localName, depth);
+                } else {
+                    // skip to the end of the unhandled end tag, without its names
+                    cursor = std::next(tagEnd);
+                    --depth;
+                }
+                if (depth < minimumDepth)
+                    minimumDepth = depth;
+                break;
+            }
+
+            case '!':
+                if (isXMLComment(cursor)) {
+                    // parse XML comment
+                    std::string_view comment(""sv);
+                    parseComment(cursor, cursorEnd, comment);
+                    if constexpr ((eventMask & XMLParserHandler::XML_COMMENT) != 0)
+                        if (!comment.empty() || !BasicXMLParser::inXMLComment)
+                            handler.handleXMLComment(comment, depth);
+
+                } else if (isCDATA(cursor)) {
+                    // parse CDATA
+                    std::string_view characters(""sv);
+                    parseCDATA(cursor, cursorEnd, characters);
+                    if constexpr ((eventMask & XMLParserHandler::CDATA) != 0)
+                        if (!characters.empty() || !BasicXMLParser::inCDATA)
+                            handler.handleCDATA(characters, depth);
+
+                } else {
+                    error(XMLParserError::INVALID_START_TAG_NAME, cursor, cursorEnd);
+                }
+                break;
+
+            case '?':
+                if (isXMLDecl(cursor)) {
+                    // parse XML declaration
+                    constexpr std::string_view startXMLDecl = "<?xml";
+                    constexpr std::string_view endXMLDecl = "?>";
+                    auto tagEnd = std::find(cursor, cursorEnd, '>');
+                    if (tagEnd == cursorEnd) {
+                        int bytesRead = refill(cursor, cursorEnd);
+                        if (bytesRead < 0) {
+                            error(XMLParserError::INPUT_ERROR, cursor, cursorEnd);
+                        }
+                        BasicXMLParser::totalBytes += bytesRead;
+                        validateDeclaration(cursor, cursorEnd, tagEnd);
+                    }
+                    if constexpr ((eventMask & XMLParserHandler::XML_DECLARATION) != 0) {
+                        std::string_view version(""sv);
+                        std::optional<std::string_view> encoding;
+                        std::optional<std::string_view> standalone;
+                        parseDeclaration(cursor, cursorEnd, startXMLDecl, endXMLDecl, tagEnd, version, encoding, standalone);
+                        handler.handleXMLDeclaration(version, encoding, standalone, depth);
+                    } else {
+                        // skip the unhandled declaration without checking it
+                        cursor = std::find_if_not(std::next(tagEnd), cursorEnd, isspace);
+                    }
+
+                } else {
+                    // parse processing instruction
+                    constexpr std::string_view endPI = "?>";
+                    auto tagEnd = std::search(cursor, cursorEnd, endPI.begin(), endPI.end());
+                    if (tagEnd == cursorEnd && BasicXMLParser::partialDocument) {
+                        // a '<' in the data cut the part of a fed document, so it is parsed with the next part
+                        BasicXMLParser::unparsedBytes = std::distance(cursor, cursorEnd);
+                        cursor = cursorEnd;
+                        break;
+                    }
+                    if (tagEnd == cursorEnd) {
+                        int bytesRead = refill(cursor, cursorEnd);
+                        if (bytesRead < 0) {
+                            error(XMLParserError::INPUT_ERROR, cursor, cursorEnd);
+                        }
+                        BasicXMLParser::totalBytes += bytesRead;
+                        validateProcessInstruction(cursor, cursorEnd, tagEnd, endPI);
+                    }
+                    if constexpr ((eventMask & XMLParserHandler::PROCESSING_INSTRUCTION) != 0) {
+                        std::string_view target(""sv);
+                        std::string_view data(""sv);
+                        parseProcessInstruction(cursor, cursorEnd, tagEnd, target, data);
+                        handler.handleProcessingInstruction(target, data, depth);
+                    } else {
+                        // skip the unhandled processing instruction
+                        cursor = std::next(tagEnd, endPI.size());
+                    }
+                }
+                break;
+
+            default:
+                // parse start tag
+                if (std::distance(cursor, cursorEnd) < 200) {
+                    auto tagEnd = std::find(cursor, cursorEnd, '>');
+                    if (tagEnd == cursorEnd) {
+                        int bytesRead = refill(cursor, cursorEnd);
+                        if (bytesRead < 0) {
+                            error(XMLParserError::INPUT_ERROR, cursor, cursorEnd);
+                        }
+                        BasicXMLParser::totalBytes += bytesRead;
+                        validateStartTag(cursor, cursorEnd, tagEnd);
+                    }
+                }
+                std::string_view prefix(""sv);
+                std::string_view qName(""sv);
+                std::string_view localName(""sv);
+                parseStartTag(cursor, cursorEnd, prefix, qName, localName);
+                if constexpr ((eventMask & XMLParserHandler::START_TAG) != 0) {
+                    if constexpr (internsNames)
+                        handler.handleElementStartTag(qName, prefix, localName, handler.elementNames.intern(qName), depth);
+                    else
+                        handler.handleElementStartTag(qName, prefix, localName, depth);
+                    if (BasicXMLParser::skipRequested && !pullsEvents) {
+                        // skip the element, with no events for its attributes or content
+                        BasicXMLParser::skipRequested = false;
+                        BasicXMLParser::inTag = false;
+                        skipElementContent(cursor, cursorEnd, true);
+                        break;
+                    }
+                }
+                if constexpr (pullsEvents)
+                    BasicXMLParser::emptyElement = *cursor == '/';
+                if (*cursor == '>') {
+                    std::advance(cursor, 1);
+                    ++depth;
+                } else if (*cursor == '/' && cursor[1] == '>') {
+                    std::advance(cursor, 2);
+                }
+                break;
+            }
+        }
+
+        if constexpr (pullsEvents) {
+            // return after each token, with the state to resume at the next one
+            BasicXMLParser::depth = depth;
+            BasicXMLParser::minimumDepth = minimumDepth;
+            BasicXMLParser::resumeCursor = cursor;
+            BasicXMLParser::resumeCursorEnd = cursorEnd;
+            return;
+        }
+    }
+
+    BasicXMLParser::depth = depth;
+    BasicXMLParser::minimumDepth = minimumDepth;
+
+    // a part of a fed document with more to come does not end it
+    if (BasicXMLParser::partialDocument)
+        return;
+    if (BasicXMLParser::inXMLComment || BasicXMLParser::inCDATA)
+        throw BasicXMLParser::unterminatedMarkup;
+    if constexpr ((eventMask & XMLParserHandler::END_DOCUMENT) != 0)
+        handler.handleEndDocument(depth);
+    endParsing();
+
+    return;
+}
+
+#undef TRACE
+#undef HEADER
+#undef FIELD
+#undef TRACE0
+#undef TRACE1
+#undef TRACE2
+#undef TRACE3
+#undef TRACE4
+#undef GET_TRACE
+
+#endif
@@ -0,0 +1,350 @@
+/*
+
+    DecompressInput.cpp
+
+    Implementation file for XML parser input that decompresses gzip, zip, or zstd
+    on a background thread
+
+*/
+
+#include "DecompressInput.hpp"
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+
+#if defined(HAVE_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+#if !defined(_MSC_VER)
+#include <sys/uio.h>
+#include <unistd.h>
+#define READ read
+#else
+#include <BaseTsd.h>
+#include <io.h>
+typedef SSIZE_T ssize_t;
+#define READ _read
+#endif
+
+// compressed input read per call, with room for a whole zip local file header
+const size_t INPUT_SIZE = 256 * 1024;
+
+// fixed part of a zip local file header
+const size_t ZIP_HEADER_SIZE = 30;
+
+// decompressor state, so the headers of the libraries stay out of DecompressInput.hpp
+struct DecompressInput::Stream {
+#if defined(HAVE_ZLIB)
+    z_stream zlib{};
+    bool zlibStarted = false;
+#endif
+#if defined(HAVE_ZSTD)
+    ZSTD_DStream* zstd = nullptr;
+#endif
+
+    ~Stream() {
+#if defined(HAVE_ZLIB)
+        if (zlibStarted)
+            inflateEnd(&zlib);
+#endif
+#if defined(HAVE_ZSTD)
+        if (zstd)
+            ZSTD_freeDStream(zstd);
+#endif
+    }
+};
+
+/*
+    Reads a little-endian integer from a zip header
+    Input: Start of the integer and its size in bytes
+    Output: Value of the integer
+*/
+static unsigned long littleEndian(const unsigned char* bytes, int size) {
+    unsigned long value = 0;
+    for (int i = size - 1; i >= 0; --i)
+        value = (value << 8) | bytes[i];
+    return value;
+}
+
+/*
+    Constructor for the ring of buffers and the decompressor
+    The format is detected from the input: gzip, the first entry of
+    a zip file, zstd when built with it, or uncompressed
+    Input: File descriptor of the compressed input, size of each buffer,
+           and number of buffers in the ring
+    Output: Initialized ring
+*/
+DecompressInput::DecompressInput(int inputFD, size_t inputBlockSize, int blockCount)
+    : ReadAheadInput(inputFD, inputBlockSize, blockCount), inputBuffer(INPUT_SIZE), stream(std::make_unique<Stream>())
+{}
+
+/*
+    Destructor that stops the reader thread before the decompressor
+    Input: N/A
+    Output: N/A
+*/
+DecompressInput::~DecompressInput() {
+    stop();
+}
+
+/*
+    Whether a file is compressed, by its extension .gz, .zip, or .zst
+    Input: Name of the file
+    Output: Whether the file is compressed
+*/
+bool DecompressInput::isCompressed(std::string_view filename) {
+    const auto extension = filename.substr(std::min(filename.size(), filename.rfind('.')));
+
+    return extension == ".gz" || extension == ".zip" || extension == ".zst";
+}
+
+/*
+    Whether this build decompresses a file, by its extension, where
+    .gz and .zip need zlib, and .zst needs zstd
+    Input: Name of the file
+    Output: Whether the file is uncompressed, or its library is built in
+*/
+bool DecompressInput::isSupported(std::string_view filename) {
+    const auto extension = filename.substr(std::min(filename.size(), filename.rfind('.')));
+#if !defined(HAVE_ZLIB)
+    if (extension == ".gz" || extension == ".zip")
+        return false;
+#endif
+#if !defined(HAVE_ZSTD)
+    if (extension == ".zst")
+        return false;
+#endif
+
+    return true;
+}
+
+/*
+    Error of the decompressor, after a refill returned -1
+    Input: N/A
+    Output: Error code, NO_ERROR if there is none
+*/
+DecompressInput::Error DecompressInput::getError() const {
+    return error;
+}
+
+/*
+    Describes the error of the decompressor, with the byte offset in
+    the compressed input that it reached for an error in the data
+    Input: N/A
+    Output: Description of the error, or empty
+*/
+std::string DecompressInput::errorMessage() const {
+    if (error == NO_ERROR)
+        return std::string();
+    if (error == UNSUPPORTED_INPUT || error == MISSING_LIBRARY || error == LIBRARY_ERROR)
+        return "decompress error : " + errorDescription;
+
+    return "decompress error : " + errorDescription + " at byte " + std::to_string(errorOffset) + " of the compressed input";
+}
+
+/*
+    Records the first error of the decompressor, so the bytes
+    decompressed before it are still parsed
+    Runs on the reader thread
+    Input: Error code, its description, and the number of bytes filled
+    Output: Number of bytes filled, or -1 when there are none
+*/
+long DecompressInput::fail(Error code, std::string message, size_t total) {
+    if (error == NO_ERROR) {
+        error = code;
+        errorDescription = std::move(message);
+        errorOffset = inputOffset - static_cast<std::int64_t>(inputEnd - inputStart);
+    }
+
+    return total > 0 ? static_cast<long>(total) : -1;
+}
+
+/*
+    Reads more compressed input, preserving the unused input
+    Input: N/A
+    Output: Number of bytes read, 0 at EOF, -1 on read error
+*/
+long DecompressInput::readInput() {
+
+    // move unused input to the start of the buffer
+    std::copy(inputBuffer.data() + inputStart, inputBuffer.data() + inputEnd, inputBuffer.data());
+    inputEnd -= inputStart;
+    inputStart = 0;
+
+    ssize_t readBytes = 0;
+    while (((readBytes = READ(fd, static_cast<void*>(inputBuffer.data() + inputEnd), inputBuffer.size() - inputEnd)) == -1) && (errno == EINTR)) {
+    }
+    if (readBytes == -1)
+        return -1;
+    if (readBytes == 0)
+        inputEOF = true;
+    inputEnd += readBytes;
+    inputOffset += readBytes;
+
+    return readBytes;
+}
+
+/*
+    Detects the format from the first bytes of the compressed input,
+    and starts the decompressor for it
+    Input: N/A
+    Output: Whether the format is supported
+*/
+bool DecompressInput::start() {
+
+    // enough input for the magic numbers, and the fixed part of a zip header
+    while (inputEnd - inputStart < ZIP_HEADER_SIZE && !inputEOF) {
+        if (readInput() == -1) {
+            fail(READ_ERROR, "Read error", 0);
+            return false;
+        }
+    }
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(inputBuffer.data() + inputStart);
+    const size_t available = inputEnd - inputStart;
+
+    if (available >= 2 && header[0] == 0x1f && header[1] == 0x8b) {
+        format = GZIP;
+    } else if (available >= ZIP_HEADER_SIZE && memcmp(header, "PK\x03\x04", 4) == 0) {
+
+        // local file header of the first entry, which is followed by its data
+        const unsigned long flags = littleEndian(header + 6, 2);
+        const unsigned long method = littleEndian(header + 8, 2);
+        const unsigned long compressedSize = littleEndian(header + 18, 4);
+        const size_t headerSize = ZIP_HEADER_SIZE + littleEndian(header + 26, 2) + littleEndian(header + 28, 2);
+        while (inputEnd - inputStart < headerSize && !inputEOF) {
+            if (readInput() == -1) {
+                fail(READ_ERROR, "Read error", 0);
+                return false;
+            }
+        }
+        if (inputEnd - inputStart < headerSize) {
+            fail(TRUNCATED_INPUT, "Truncated zip header", 0);
+            return false;
+        }
+        inputStart += headerSize;
+        if (method == 0 && !(flags & 0x08)) {
+            format = ZIP_STORED;
+            storedRemaining = compressedSize;
+        } else if (method == 8) {
+            format = ZIP_DEFLATE;
+        } else {
+            fail(UNSUPPORTED_INPUT, "Unsupported zip entry, method " + std::to_string(method), 0);
+            return false;
+        }
+    } else if (available >= 4 && memcmp(header, "\x28\xb5\x2f\xfd", 4) == 0) {
+        format = ZSTD;
+    } else {
+        format = NONE;
+    }
+
+    if (format == GZIP || format == ZIP_DEFLATE) {
+#if defined(HAVE_ZLIB)
+        // automatic gzip header detection, or a raw deflate stream for zip
+        if (inflateInit2(&stream->zlib, format == GZIP ? 15 + 32 : -15) != Z_OK) {
+            fail(LIBRARY_ERROR, "Unable to start zlib", 0);
+            return false;
+        }
+        stream->zlibStarted = true;
+#else
+        fail(MISSING_LIBRARY, "Built without zlib for gzip and zip input", 0);
+        return false;
+#endif
+    } else if (format == ZSTD) {
+#if defined(HAVE_ZSTD)
+        stream->zstd = ZSTD_createDStream();
+        if (!stream->zstd || ZSTD_isError(ZSTD_initDStream(stream->zstd))) {
+            fail(LIBRARY_ERROR, "Unable to start zstd", 0);
+            return false;
+        }
+#else
+        fail(MISSING_LIBRARY, "Built without zstd for zstd input", 0);
+        return false;
+#endif
+    }
+
+    return true;
+}
+
+/*
+    Decompresses until the buffer is full or the end of the input
+    Runs on the reader thread
+    Input: Start of the buffer and its size
+    Output: Number of bytes filled, less than size only at EOF or before an error, -1 on error
+*/
+long DecompressInput::fill(char* data, size_t size) {
+    if (error != NO_ERROR || (format == UNKNOWN && !start()))
+        return -1;
+
+    size_t total = 0;
+    while (total < size && !streamEnd) {
+
+        // more compressed input when it is used up
+        if (inputStart == inputEnd && !inputEOF && readInput() == -1)
+            return fail(READ_ERROR, "Read error", total);
+        const bool noInput = inputStart == inputEnd && inputEOF;
+
+        if (format == NONE || format == ZIP_STORED) {
+            size_t count = std::min(inputEnd - inputStart, size - total);
+            if (format == ZIP_STORED)
+                count = std::min(count, static_cast<size_t>(storedRemaining));
+            std::copy_n(inputBuffer.data() + inputStart, count, data + total);
+            inputStart += count;
+            total += count;
+            if (format == ZIP_STORED) {
+                storedRemaining -= count;
+                if (storedRemaining > 0 && noInput)
+                    return fail(TRUNCATED_INPUT, "Truncated zip entry", total);
+            }
+            if (noInput || (format == ZIP_STORED && storedRemaining == 0))
+                streamEnd = true;
+        } else if (format == GZIP || format == ZIP_DEFLATE) {
+#if defined(HAVE_ZLIB)
+            z_stream& zlib = stream->zlib;
+            zlib.next_in = reinterpret_cast<Bytef*>(inputBuffer.data() + inputStart);
+            zlib.avail_in = static_cast<uInt>(inputEnd - inputStart);
+            zlib.next_out = reinterpret_cast<Bytef*>(data + total);
+            zlib.avail_out = static_cast<uInt>(size - total);
+            const int status = inflate(&zlib, Z_NO_FLUSH);
+            inputStart = inputEnd - zlib.avail_in;
+            total = size - zlib.avail_out;
+            if (status == Z_STREAM_END) {
+
+                // a gzip file may be several members, concatenated
+                if (format == GZIP && inputStart == inputEnd && !inputEOF && readInput() == -1)
+                    return fail(READ_ERROR, "Read error", total);
+                if (format == GZIP && inputStart < inputEnd)
+                    inflateReset(&zlib);
+                else
+                    streamEnd = true;
+            } else if (status == Z_BUF_ERROR && noInput) {
+                return fail(TRUNCATED_INPUT, "Truncated input", total);
+            } else if (status != Z_OK && status != Z_BUF_ERROR) {
+                return fail(INVALID_INPUT, "Invalid compressed data", total);
+            }
+#endif
+        } else if (format == ZSTD) {
+#if defined(HAVE_ZSTD)
+            ZSTD_inBuffer in = { inputBuffer.data() + inputStart, inputEnd - inputStart, 0 };
+            ZSTD_outBuffer out = { data + total, size - total, 0 };
+            const size_t status = ZSTD_decompressStream(stream->zstd, &out, &in);
+            if (ZSTD_isError(status))
+                return fail(INVALID_INPUT, ZSTD_getErrorName(status), total);
+            inputStart += in.pos;
+            total += out.pos;
+
+            // a frame is complete at status 0, and the input may hold further frames
+            if (inputStart == inputEnd && inputEOF && total < size) {
+                if (status != 0)
+                    return fail(TRUNCATED_INPUT, "Truncated input", total);
+                streamEnd = true;
+            }
+#endif
+        }
+    }
+
+    return static_cast<long>(total);
+}
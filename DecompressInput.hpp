@@ -0,0 +1,128 @@
+/*
+
+    DecompressInput.hpp
+
+    Include file for XML parser input that decompresses gzip, zip, or zstd
+    on a background thread
+
+*/
+
+#ifndef DECOMPRESSINPUT_HPP
+#define DECOMPRESSINPUT_HPP
+
+#include "ReadAheadInput.hpp"
+#include <vector>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+class DecompressInput : public ReadAheadInput {
+public:
+    // errors of the decompressor
+    enum Error { NO_ERROR, READ_ERROR, TRUNCATED_INPUT, INVALID_INPUT, UNSUPPORTED_INPUT, MISSING_LIBRARY, LIBRARY_ERROR };
+
+private:
+    /*
+        Detects the format from the first bytes of the compressed input,
+        and starts the decompressor for it
+        Input: N/A
+        Output: Whether the format is supported
+    */
+    bool start();
+
+    /*
+        Reads more compressed input, preserving the unused input
+        Input: N/A
+        Output: Number of bytes read, 0 at EOF, -1 on read error
+    */
+    long readInput();
+
+    /*
+        Decompresses until the buffer is full or the end of the input
+        Runs on the reader thread
+        Input: Start of the buffer and its size
+        Output: Number of bytes filled, less than size only at EOF or before an error, -1 on error
+    */
+    long fill(char* data, size_t size) override;
+
+    /*
+        Records the first error of the decompressor, so the bytes
+        decompressed before it are still parsed
+        Runs on the reader thread
+        Input: Error code, its description, and the number of bytes filled
+        Output: Number of bytes filled, or -1 when there are none
+    */
+    long fail(Error code, std::string message, size_t total);
+
+    enum Format { UNKNOWN, NONE, GZIP, ZIP_STORED, ZIP_DEFLATE, ZSTD };
+
+    struct Stream;
+
+    std::vector<char> inputBuffer;
+    size_t inputStart = 0;
+    size_t inputEnd = 0;
+    bool inputEOF = false;
+    long storedRemaining = 0;
+    bool streamEnd = false;
+    Format format = UNKNOWN;
+    std::unique_ptr<Stream> stream;
+    std::int64_t inputOffset = 0;
+    Error error = NO_ERROR;
+    std::string errorDescription;
+    std::int64_t errorOffset = 0;
+
+public:
+    /*
+        Constructor for the ring of buffers and the decompressor
+        The format is detected from the input: gzip, the first entry of
+        a zip file, zstd when built with it, or uncompressed
+        Input: File descriptor of the compressed input, size of each buffer,
+               and number of buffers in the ring
+        Output: Initialized ring
+    */
+    DecompressInput(int inputFD = 0, size_t inputBlockSize = 4 * 1024 * 1024, int blockCount = 3);
+
+    /*
+        Destructor that stops the reader thread before the decompressor
+        Input: N/A
+        Output: N/A
+    */
+    ~DecompressInput() override;
+
+    DecompressInput(const DecompressInput&) = delete;
+    DecompressInput& operator=(const DecompressInput&) = delete;
+
+    /*
+        Whether a file is compressed, by its extension .gz, .zip, or .zst
+        Input: Name of the file
+        Output: Whether the file is compressed
+    */
+    static bool isCompressed(std::string_view filename);
+
+    /*
+        Whether this build decompresses a file, by its extension, where
+        .gz and .zip need zlib, and .zst needs zstd
+        Input: Name of the file
+        Output: Whether the file is uncompressed, or its library is built in
+    */
+    static bool isSupported(std::string_view filename);
+
+    /*
+        Error of the decompressor, after a refill returned -1
+        Input: N/A
+        Output: Error code, NO_ERROR if there is none
+    */
+    Error getError() const;
+
+    /*
+        Describes the error of the decompressor, with the byte offset in
+        the compressed input that it reached for an error in the data
+        Input: N/A
+        Output: Description of the error, or empty
+    */
+    std::string errorMessage() const override;
+};
+
+#endif
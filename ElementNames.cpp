@@ -0,0 +1,160 @@
+/*
+
+    ElementNames.cpp
+
+    Implementation file for the symbol table of element names, with an
+    integer ID for each qualified name
+
+*/
+
+#include "ElementNames.hpp"
+#include <array>
+#include <iterator>
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+// names of the srcML vocabulary, in the order of their IDs
+static constexpr std::string_view vocabulary[] = {
+    "unit"sv, "name"sv, "expr"sv, "expr_stmt"sv, "operator"sv, "call"sv, "argument_list"sv,
+    "argument"sv, "literal"sv, "type"sv, "block"sv, "block_content"sv, "decl"sv, "decl_stmt"sv,
+    "init"sv, "condition"sv, "if_stmt"sv, "if"sv, "else"sv, "then"sv, "while"sv, "for"sv,
+    "control"sv, "incr"sv, "do"sv, "switch"sv, "case"sv, "default"sv, "break"sv, "continue"sv,
+    "return"sv, "goto"sv, "label"sv, "empty_stmt"sv, "function"sv, "function_decl"sv,
+    "constructor"sv, "constructor_decl"sv, "destructor"sv, "destructor_decl"sv, "parameter_list"sv,
+    "parameter"sv, "specifier"sv, "modifier"sv, "index"sv, "range"sv, "comment"sv, "class"sv,
+    "class_decl"sv, "struct"sv, "struct_decl"sv, "union"sv, "union_decl"sv, "enum"sv,
+    "enum_decl"sv, "typedef"sv, "using"sv, "namespace"sv, "template"sv, "private"sv, "public"sv,
+    "protected"sv, "super_list"sv, "super"sv, "member_init_list"sv, "friend"sv, "lambda"sv,
+    "capture"sv, "cast"sv, "ternary"sv, "sizeof"sv, "alignof"sv, "typeid"sv, "noexcept"sv,
+    "decltype"sv, "try"sv, "catch"sv, "throw"sv, "throws"sv, "static_assert"sv, "asm"sv,
+    "extern"sv, "annotation"sv, "import"sv, "package"sv, "interface"sv, "interface_decl"sv,
+    "annotation_defn"sv, "static"sv, "synchronized"sv, "finally"sv, "foreach"sv, "lock"sv,
+    "fixed"sv, "checked"sv, "unchecked"sv, "unsafe"sv, "using_stmt"sv, "property"sv, "event"sv,
+    "delegate"sv, "attribute"sv, "where"sv, "constraint"sv, "yield"sv, "macro"sv, "escape"sv,
+    "cpp:directive"sv, "cpp:file"sv, "cpp:include"sv, "cpp:define"sv, "cpp:undef"sv, "cpp:if"sv,
+    "cpp:ifdef"sv, "cpp:ifndef"sv, "cpp:elif"sv, "cpp:else"sv, "cpp:endif"sv, "cpp:macro"sv,
+    "cpp:value"sv, "cpp:error"sv, "cpp:warning"sv, "cpp:pragma"sv, "cpp:line"sv, "cpp:empty"sv,
+    "cpp:number"sv, "cpp:literal"sv, "cpp:region"sv, "cpp:endregion"sv
+};
+
+static_assert(std::size(vocabulary) == ElementNames::VOCABULARY_SIZE, "an ID for each name of the vocabulary");
+
+// slots of the perfect hash table, a power of 2 large enough for a seed with no collisions
+constexpr unsigned int HASH_SLOTS = 2048;
+
+// slot with no name
+constexpr unsigned char EMPTY_SLOT = 0xFF;
+
+/*
+    Hashes a name, FNV-1a with a seed, to a slot of the table
+    Input: Name and seed
+    Output: Slot of the name
+*/
+static constexpr unsigned int hashName(std::string_view name, unsigned int seed) {
+    unsigned int hash = seed;
+    for (const char c : name)
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;
+
+    return (hash ^ (hash >> 16)) & (HASH_SLOTS - 1);
+}
+
+// perfect hash table of the vocabulary, with the seed that has no collisions
+struct HashTable {
+    unsigned int seed = 0;
+    std::array<unsigned char, HASH_SLOTS> slots{};
+};
+
+/*
+    Searches for the first seed with no collisions in the vocabulary,
+    at compile time, so the vocabulary can change without a new seed
+    Input: N/A
+    Output: Table of the vocabulary
+*/
+static constexpr HashTable makeHashTable() {
+    HashTable table;
+    for (table.seed = 2166136261U; ; ++table.seed) {
+        for (auto& slot : table.slots)
+            slot = EMPTY_SLOT;
+        bool collision = false;
+        for (int id = 0; id < ElementNames::VOCABULARY_SIZE && !collision; ++id) {
+            auto& slot = table.slots[hashName(vocabulary[id], table.seed)];
+            collision = slot != EMPTY_SLOT;
+            slot = static_cast<unsigned char>(id);
+        }
+        if (!collision)
+            return table;
+    }
+}
+
+static_assert(ElementNames::VOCABULARY_SIZE < EMPTY_SLOT, "an ID of the vocabulary fits in a slot");
+
+static constexpr HashTable hashTable = makeHashTable();
+
+/*
+    Finds the ID of a name of the srcML vocabulary with a perfect hash,
+    i.e., one hash and one comparison, or for a prefixed name that is not
+    in the vocabulary, e.g., src:expr, the ID of its local name
+    Input: Qualified name
+    Output: ID of the name, or -1 if it is not in the vocabulary
+*/
+int ElementNames::find(std::string_view qName) {
+    const unsigned char id = hashTable.slots[hashName(qName, hashTable.seed)];
+    if (id != EMPTY_SLOT && vocabulary[id] == qName)
+        return id;
+
+    // the src namespace with a prefix, where the names of the cpp
+    // namespace are already found with theirs
+    const auto colonPosition = qName.find(':');
+    if (colonPosition == std::string_view::npos)
+        return -1;
+    const std::string_view localName = qName.substr(colonPosition + 1);
+    const unsigned char localID = hashTable.slots[hashName(localName, hashTable.seed)];
+    if (localID == EMPTY_SLOT || vocabulary[localID] != localName)
+        return -1;
+
+    return localID;
+}
+
+/*
+    Interns a qualified name: the ID of a name of the srcML vocabulary,
+    or the ID of another name, assigned the first time it is interned
+    Input: Qualified name
+    Output: ID of the name
+*/
+int ElementNames::intern(std::string_view qName) {
+    const int id = find(qName);
+    if (id != -1)
+        return id;
+
+    // other names are rare in srcML, so a map is enough
+    const auto other = otherIDs.find(qName);
+    if (other != otherIDs.end())
+        return other->second;
+    const int otherID = VOCABULARY_SIZE + static_cast<int>(otherNames.size());
+    otherIDs.emplace(std::string(qName), otherID);
+    otherNames.emplace_back(qName);
+
+    return otherID;
+}
+
+/*
+    Qualified name of an ID
+    Input: ID of the name
+    Output: Qualified name
+*/
+std::string_view ElementNames::name(int id) const {
+    if (id < VOCABULARY_SIZE)
+        return vocabulary[id];
+
+    return otherNames[id - VOCABULARY_SIZE];
+}
+
+/*
+    Number of IDs, i.e., the size of an array indexed by ID
+    Input: N/A
+    Output: Number of IDs
+*/
+int ElementNames::size() const {
+    return VOCABULARY_SIZE + static_cast<int>(otherNames.size());
+}
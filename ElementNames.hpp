@@ -0,0 +1,78 @@
+/*
+
+    ElementNames.hpp
+
+    Include file for the symbol table of element names, with an integer
+    ID for each qualified name
+
+*/
+
+#ifndef ELEMENTNAMES_HPP
+#define ELEMENTNAMES_HPP
+
+#include <string>
+#include <string_view>
+#include <map>
+#include <vector>
+#include <functional>
+
+class ElementNames {
+public:
+    // IDs of the srcML vocabulary, with the IDs of other names after them
+    enum ID : int {
+        UNIT, NAME, EXPR, EXPR_STMT, OPERATOR, CALL, ARGUMENT_LIST, ARGUMENT, LITERAL, TYPE, BLOCK,
+        BLOCK_CONTENT, DECL, DECL_STMT, INIT, CONDITION, IF_STMT, IF, ELSE, THEN, WHILE, FOR,
+        CONTROL, INCR, DO, SWITCH, CASE, DEFAULT, BREAK, CONTINUE, RETURN, GOTO, LABEL, EMPTY_STMT,
+        FUNCTION, FUNCTION_DECL, CONSTRUCTOR, CONSTRUCTOR_DECL, DESTRUCTOR, DESTRUCTOR_DECL,
+        PARAMETER_LIST, PARAMETER, SPECIFIER, MODIFIER, INDEX, RANGE, COMMENT, CLASS, CLASS_DECL,
+        STRUCT, STRUCT_DECL, UNION, UNION_DECL, ENUM, ENUM_DECL, TYPEDEF, USING, NAMESPACE,
+        TEMPLATE, PRIVATE, PUBLIC, PROTECTED, SUPER_LIST, SUPER, MEMBER_INIT_LIST, FRIEND, LAMBDA,
+        CAPTURE, CAST, TERNARY, SIZEOF, ALIGNOF, TYPEID, NOEXCEPT, DECLTYPE, TRY, CATCH, THROW,
+        THROWS, STATIC_ASSERT, ASM, EXTERN, ANNOTATION, IMPORT, PACKAGE, INTERFACE, INTERFACE_DECL,
+        ANNOTATION_DEFN, STATIC, SYNCHRONIZED, FINALLY, FOREACH, LOCK, FIXED, CHECKED, UNCHECKED,
+        UNSAFE, USING_STMT, PROPERTY, EVENT, DELEGATE, ATTRIBUTE, WHERE, CONSTRAINT, YIELD, MACRO,
+        ESCAPE, CPP_DIRECTIVE, CPP_FILE, CPP_INCLUDE, CPP_DEFINE, CPP_UNDEF, CPP_IF, CPP_IFDEF,
+        CPP_IFNDEF, CPP_ELIF, CPP_ELSE, CPP_ENDIF, CPP_MACRO, CPP_VALUE, CPP_ERROR, CPP_WARNING,
+        CPP_PRAGMA, CPP_LINE, CPP_EMPTY, CPP_NUMBER, CPP_LITERAL, CPP_REGION, CPP_ENDREGION,
+        VOCABULARY_SIZE
+    };
+
+    /*
+        Finds the ID of a name of the srcML vocabulary with a perfect hash,
+        i.e., one hash and one comparison, or for a prefixed name that is not
+        in the vocabulary, e.g., src:expr, the ID of its local name
+        Input: Qualified name
+        Output: ID of the name, or -1 if it is not in the vocabulary
+    */
+    static int find(std::string_view qName);
+
+    /*
+        Interns a qualified name: the ID of a name of the srcML vocabulary,
+        or the ID of another name, assigned the first time it is interned
+        Input: Qualified name
+        Output: ID of the name
+    */
+    int intern(std::string_view qName);
+
+    /*
+        Qualified name of an ID
+        Input: ID of the name
+        Output: Qualified name
+    */
+    std::string_view name(int id) const;
+
+    /*
+        Number of IDs, i.e., the size of an array indexed by ID
+        Input: N/A
+        Output: Number of IDs
+    */
+    int size() const;
+
+private:
+    // names outside the vocabulary, in the order of their IDs, with no
+    // views into the map, so a copy of the table is independent
+    std::map<std::string, int, std::less<>> otherIDs;
+    std::vector<std::string> otherNames;
+};
+
+#endif
@@ -0,0 +1,108 @@
+/*
+
+    MappedFile.cpp
+
+    Implementation file for read-only memory-mapped input files
+
+*/
+
+#include "MappedFile.hpp"
+
+#if !defined(_MSC_VER)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+/*
+    Constructor that maps the whole file read-only
+    The mapping is followed by at least one page of zero bytes,
+    so lookahead past the end of the document is safe
+    Input: Path of the file
+    Output: Mapped file, or an invalid object if the file cannot be mapped
+*/
+MappedFile::MappedFile(const std::string &path) {
+#if !defined(_MSC_VER)
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+    struct stat st;
+    if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return;
+    }
+    size = static_cast<size_t>(st.st_size);
+    valid = true;
+    if (size == 0) {
+        close(fd);
+        return;
+    }
+
+    // reserve the file size plus a trailing page of anonymous zero bytes,
+    // then map the file over the start of the reservation
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    mappedSize = (size / pageSize + 1) * pageSize;
+    void* region = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        close(fd);
+        valid = false;
+        return;
+    }
+    if (mmap(region, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(region, mappedSize);
+        close(fd);
+        valid = false;
+        return;
+    }
+    close(fd);
+
+    // input is read once, front to back
+    madvise(region, size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(region, size, MADV_HUGEPAGE);
+#endif
+    data = static_cast<const char*>(region);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return;
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    size = contents.size();
+    data = contents.data();
+    valid = true;
+#endif
+}
+
+/*
+    Destructor that unmaps the file
+    Input: N/A
+    Output: N/A
+*/
+MappedFile::~MappedFile() {
+#if !defined(_MSC_VER)
+    if (mappedSize)
+        munmap(const_cast<char*>(data), mappedSize);
+#endif
+}
+
+/*
+    Returns if the file was opened and mapped
+    Input: N/A
+    Output: Bool value for if the mapping is usable
+*/
+bool MappedFile::isValid() const {
+    return valid;
+}
+
+/*
+    Returns the contents of the file
+    Input: N/A
+    Output: View of the whole mapped file
+*/
+std::string_view MappedFile::view() const {
+    return std::string_view(data, size);
+}
@@ -0,0 +1,60 @@
+/*
+
+    MappedFile.hpp
+
+    Include file for read-only memory-mapped input files
+
+*/
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <string>
+#include <string_view>
+
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t mappedSize = 0;
+    bool valid = false;
+#if defined(_MSC_VER)
+    std::string contents;
+#endif
+
+public:
+    /*
+        Constructor that maps the whole file read-only
+        The mapping is followed by at least one page of zero bytes,
+        so lookahead past the end of the document is safe
+        Input: Path of the file
+        Output: Mapped file, or an invalid object if the file cannot be mapped
+    */
+    MappedFile(const std::string &path);
+
+    /*
+        Destructor that unmaps the file
+        Input: N/A
+        Output: N/A
+    */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /*
+        Returns if the file was opened and mapped
+        Input: N/A
+        Output: Bool value for if the mapping is usable
+    */
+    bool isValid() const;
+
+    /*
+        Returns the contents of the file
+        Input: N/A
+        Output: View of the whole mapped file
+    */
+    std::string_view view() const;
+};
+
+#endif
@@ -0,0 +1,202 @@
+/*
+
+    ReadAheadInput.cpp
+
+    Implementation file for XML parser input that reads ahead on a background thread
+
+*/
+
+#include "ReadAheadInput.hpp"
+#include <algorithm>
+#include <errno.h>
+
+#if !defined(_MSC_VER)
+#include <sys/uio.h>
+#include <unistd.h>
+#define READ read
+#else
+#include <BaseTsd.h>
+#include <io.h>
+typedef SSIZE_T ssize_t;
+#define READ _read
+#endif
+
+// zero bytes after the data of each block so lookahead stays in bounds
+const size_t BLOCK_PADDING = 16;
+
+// starting room in front of the data of each block, grown for a longer token
+const size_t FRONT_SIZE = 4096;
+
+/*
+    Constructor for the ring of buffers
+    The reader thread starts on the first refill, so that
+    a derived input is fully constructed before fill() runs
+    Input: File descriptor, size of each buffer, and number of buffers in the ring
+    Output: Initialized ring
+*/
+ReadAheadInput::ReadAheadInput(int inputFD, size_t inputBlockSize, int blockCount)
+    : blockSize(inputBlockSize), blocks(std::max(blockCount, 2)), fd(inputFD)
+{
+    // each block has room in front of the data for the unprocessed tail
+    // of the previous block, so a token that straddles blocks is contiguous,
+    // and is not initialized, so a small input only touches what it reads
+    for (int i = 0; i < static_cast<int>(blocks.size()); ++i) {
+        blocks[i].front = std::min(FRONT_SIZE, blockSize);
+        blocks[i].data.reset(new char[blocks[i].front + blockSize + BLOCK_PADDING]);
+        freeBlocks.push_back(i);
+    }
+}
+
+/*
+    Grows the room in front of the data of a block, moving its data,
+    so the unprocessed content of the previous block fits
+    Input: Block and the number of unprocessed characters
+    Output: Block with at least that much room in front of its data
+*/
+void ReadAheadInput::growFront(Block& block, size_t unprocessed) {
+    size_t front = block.front;
+    while (front < unprocessed)
+        front *= 2;
+    front = std::min(front, blockSize);
+
+    std::unique_ptr<char[]> data(new char[front + blockSize + BLOCK_PADDING]);
+    std::copy_n(block.data.get() + block.front, std::max(block.size, 0L) + BLOCK_PADDING, data.get() + front);
+    block.data = std::move(data);
+    block.front = front;
+}
+
+/*
+    Destructor that stops the reader thread
+    Input: N/A
+    Output: N/A
+*/
+ReadAheadInput::~ReadAheadInput() {
+    stop();
+}
+
+/*
+    Stops the reader thread. A derived input calls this in its
+    destructor, before the state that fill() uses is destroyed.
+    Input: N/A
+    Output: N/A
+*/
+void ReadAheadInput::stop() {
+    if (!reader.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    blockFreed.notify_all();
+    reader.join();
+}
+
+/*
+    Virtual function that fills a buffer, by default with a read
+    of the file descriptor. Runs on the reader thread.
+    Input: Start of the buffer and its size
+    Output: Number of bytes filled, less than size only at EOF, -1 on read error
+*/
+long ReadAheadInput::fill(char* data, size_t size) {
+    long total = 0;
+    while (total < static_cast<long>(size)) {
+        ssize_t readBytes = 0;
+        while (((readBytes = READ(fd, static_cast<void*>(data + total), size - total)) == -1) && (errno == EINTR)) {
+        }
+        if (readBytes == -1)
+            return -1;
+        if (readBytes == 0)
+            break;
+        total += readBytes;
+    }
+
+    return total;
+}
+
+/*
+    Fills free buffers until EOF or error
+    Runs on the reader thread
+    Input: N/A
+    Output: Filled buffers queued for the parser
+*/
+void ReadAheadInput::readLoop() {
+    while (true) {
+        int index = -1;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            blockFreed.wait(lock, [this] { return stopping || !freeBlocks.empty(); });
+            if (stopping)
+                return;
+            index = freeBlocks.front();
+            freeBlocks.pop_front();
+        }
+
+        // fill the whole block, so the parser refills once per block
+        Block& block = blocks[index];
+        char* data = block.data.get() + block.front;
+        const long total = fill(data, blockSize);
+        std::fill_n(data + std::max(total, 0L), BLOCK_PADDING, '\0');
+        block.size = total;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            filledBlocks.push_back(index);
+        }
+        blockFilled.notify_one();
+
+        // an empty block marks EOF or an error, and is the last one
+        if (total <= 0)
+            return;
+    }
+}
+
+/*
+    Moves to the next filled buffer, stitching the unprocessed
+    content of the current buffer in front of the new data
+    Input: Start and end iterators of unprocessed segment by ref
+    Output: Number of bytes read, 0 at EOF, -1 on read error; adjusted iterators by ref
+*/
+int ReadAheadInput::refill(const char* &cursor, const char* &cursorEnd) {
+
+    // number of unprocessed characters [cursor, cursorEnd)
+    const size_t unprocessed = std::distance(cursor, cursorEnd);
+    if (unprocessed > blockSize)
+        return -1;
+
+    // after EOF or error there are no more blocks, and the unprocessed content stays
+    if (current != -1 && blocks[current].size <= 0)
+        return static_cast<int>(blocks[current].size);
+
+    // start reading ahead on the first refill
+    if (current == -1 && !reader.joinable())
+        reader = std::thread(&ReadAheadInput::readLoop, this);
+
+    int next = -1;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        blockFilled.wait(lock, [this] { return !filledBlocks.empty(); });
+        next = filledBlocks.front();
+        filledBlocks.pop_front();
+    }
+
+    // move unprocessed characters in front of the new data, then release the current block
+    Block& block = blocks[next];
+    if (unprocessed > block.front)
+        growFront(block, unprocessed);
+    char* data = block.data.get() + block.front;
+    std::copy(cursor, cursorEnd, data - unprocessed);
+    if (current != -1) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            freeBlocks.push_back(current);
+        }
+        blockFreed.notify_one();
+    }
+    current = next;
+
+    // at EOF or read error, only the unprocessed characters
+    cursor = data - unprocessed;
+    cursorEnd = data + std::max(block.size, 0L);
+
+    return static_cast<int>(block.size);
+}
@@ -0,0 +1,104 @@
+/*
+
+    ReadAheadInput.hpp
+
+    Include file for XML parser input that reads ahead on a background thread
+
+*/
+
+#ifndef READAHEADINPUT_HPP
+#define READAHEADINPUT_HPP
+
+#include "XMLParserInput.hpp"
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class ReadAheadInput : public XMLParserInput {
+private:
+    /*
+        Fills free buffers until EOF or error
+        Runs on the reader thread
+        Input: N/A
+        Output: Filled buffers queued for the parser
+    */
+    void readLoop();
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t front = 0;
+        long size = 0;
+    };
+
+    /*
+        Grows the room in front of the data of a block, moving its data,
+        so the unprocessed content of the previous block fits
+        Input: Block and the number of unprocessed characters
+        Output: Block with at least that much room in front of its data
+    */
+    void growFront(Block& block, size_t unprocessed);
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    std::deque<int> freeBlocks;
+    std::deque<int> filledBlocks;
+    int current = -1;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable blockFilled;
+    std::condition_variable blockFreed;
+    std::thread reader;
+
+protected:
+    /*
+        Virtual function that fills a buffer, by default with a read
+        of the file descriptor. Runs on the reader thread.
+        Input: Start of the buffer and its size
+        Output: Number of bytes filled, less than size only at EOF, -1 on read error
+    */
+    virtual long fill(char* data, size_t size);
+
+    /*
+        Stops the reader thread. A derived input calls this in its
+        destructor, before the state that fill() uses is destroyed.
+        Input: N/A
+        Output: N/A
+    */
+    void stop();
+
+    int fd;
+
+public:
+    /*
+        Constructor for the ring of buffers
+        The reader thread starts on the first refill, so that
+        a derived input is fully constructed before fill() runs
+        Input: File descriptor, size of each buffer, and number of buffers in the ring
+        Output: Initialized ring
+    */
+    ReadAheadInput(int inputFD = 0, size_t inputBlockSize = 4 * 1024 * 1024, int blockCount = 3);
+
+    /*
+        Destructor that stops the reader thread
+        Input: N/A
+        Output: N/A
+    */
+    ~ReadAheadInput() override;
+
+    ReadAheadInput(const ReadAheadInput&) = delete;
+    ReadAheadInput& operator=(const ReadAheadInput&) = delete;
+
+    /*
+        Moves to the next filled buffer, stitching the unprocessed
+        content of the current buffer in front of the new data
+        Input: Start and end iterators of unprocessed segment by ref
+        Output: Number of bytes read, 0 at EOF, -1 on read error; adjusted iterators by ref
+    */
+    int refill(const char* &cursor, const char* &cursorEnd) override;
+};
+
+#endif
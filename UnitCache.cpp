@@ -0,0 +1,187 @@
+/*
+
+    UnitCache.cpp
+
+    Implementation file for the cache of the measures of units by their content
+
+*/
+
+#include "UnitCache.hpp"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <tuple>
+
+// first bytes of a cache file, with the version of its format
+const char CACHE_MAGIC[8] = { 'S', 'R', 'C', 'F', 'U', 'C', '0', '1' };
+
+// rows with the same start tag, e.g., with no filename, that are checked for a unit
+const int MAXIMUM_CANDIDATES = 8;
+
+// primes of XXH64
+const std::uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+const std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+const std::uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+const std::uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+const std::uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+/*
+    Rotates a 64-bit value left
+    Input: Value and number of bits
+    Output: Rotated value
+*/
+static std::uint64_t rotateLeft(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+/*
+    Mixes 8 bytes of input into a lane of the hash
+    Input: Lane and input
+    Output: Updated lane
+*/
+static std::uint64_t mixLane(std::uint64_t lane, std::uint64_t input) {
+    return rotateLeft(lane + input * PRIME2, 31) * PRIME1;
+}
+
+/*
+    Reads 8 or 4 bytes at any alignment
+    Input: Start of the bytes
+    Output: Bytes as an integer in native order
+*/
+template <class Integer>
+static Integer readBytes(const char* bytes) {
+    Integer value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+/*
+    Hashes the bytes of a unit, 32 bytes at a time in four lanes,
+    as in XXH64
+    Input: Bytes of the unit
+    Output: 64-bit hash
+*/
+std::uint64_t UnitCache::hash(std::string_view bytes) {
+    const char* cursor = bytes.data();
+    const char* const end = cursor + bytes.size();
+
+    std::uint64_t hash = PRIME5;
+    if (bytes.size() >= 32) {
+        std::uint64_t lanes[4] = { PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1 };
+        for (; std::distance(cursor, end) >= 32; cursor += 32) {
+            for (int lane = 0; lane < 4; ++lane)
+                lanes[lane] = mixLane(lanes[lane], readBytes<std::uint64_t>(cursor + lane * 8));
+        }
+        hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+        for (const auto lane : lanes)
+            hash = (hash ^ mixLane(0, lane)) * PRIME1 + PRIME4;
+    }
+    hash += bytes.size();
+
+    // rest of the bytes, fewer than 32
+    for (; std::distance(cursor, end) >= 8; cursor += 8)
+        hash = rotateLeft(hash ^ mixLane(0, readBytes<std::uint64_t>(cursor)), 27) * PRIME1 + PRIME4;
+    if (std::distance(cursor, end) >= 4) {
+        hash = rotateLeft(hash ^ (readBytes<std::uint32_t>(cursor) * PRIME1), 23) * PRIME2 + PRIME3;
+        cursor += 4;
+    }
+    for (; cursor != end; ++cursor)
+        hash = rotateLeft(hash ^ (static_cast<unsigned char>(*cursor) * PRIME5), 11) * PRIME1;
+
+    // avalanche, so every input bit affects every output bit
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+/*
+    Maps a cache file, with its rows used in place
+    Input: Path of the cache file
+    Output: Mapped rows; bool value for whether it is a cache of this version
+*/
+bool UnitCache::load(const std::string &path) {
+    file = std::make_unique<MappedFile>(path);
+    const std::string_view contents = file->view();
+    if (!file->isValid() || contents.size() < sizeof(Header))
+        return false;
+
+    Header header;
+    std::memcpy(&header, contents.data(), sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.measureCount != srcFactsParser::UNIT_MEASURES
+        || header.rowSize != sizeof(Row) || contents.size() != sizeof(Header) + header.rowCount * sizeof(Row))
+        return false;
+
+    // the mapping is page aligned, and the header keeps the rows aligned
+    table = reinterpret_cast<const Row*>(contents.data() + sizeof(Header));
+    tableSize = static_cast<std::size_t>(header.rowCount);
+
+    return true;
+}
+
+/*
+    Finds the measures of an unchanged unit in the mapped rows, i.e.,
+    one with the hash of its start tag whose bytes have the hash
+    and length of the row
+    Input: Hash of the start tag, and the document from the start of the unit
+    Output: Row of the unit, or nullptr if it is not in the cache
+*/
+const UnitCache::Row* UnitCache::find(std::uint64_t tagHash, std::string_view unit) const {
+    const Row* const tableEnd = table + tableSize;
+    const Row* row = std::lower_bound(table, tableEnd, tagHash, [](const Row& row, std::uint64_t value) { return row.tagHash < value; });
+    for (int candidate = 0; row != tableEnd && row->tagHash == tagHash && candidate < MAXIMUM_CANDIDATES; ++row, ++candidate) {
+        if (row->length > 0 && row->length <= static_cast<std::int64_t>(unit.size()) && unit[row->length - 1] == '>'
+            && hash(unit.substr(0, row->length)) == row->hash)
+            return row;
+    }
+
+    return nullptr;
+}
+
+/*
+    Adds a row to write with save
+    Input: Row of a unit
+    Output: N/A
+*/
+void UnitCache::add(const Row &row) {
+    rows.push_back(row);
+
+    return;
+}
+
+/*
+    Writes the added rows sorted by the hash of the start tag, to a
+    temporary file renamed over the cache, so the mapped rows stay valid
+    Input: Path of the cache file
+    Output: Cache file; bool value for whether it was written
+*/
+bool UnitCache::save(const std::string &path) {
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        return std::tie(a.tagHash, a.hash, a.length) < std::tie(b.tagHash, b.hash, b.length);
+    });
+    rows.erase(std::unique(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        return a.tagHash == b.tagHash && a.hash == b.hash && a.length == b.length;
+    }), rows.end());
+
+    Header header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.measureCount = srcFactsParser::UNIT_MEASURES;
+    header.rowSize = sizeof(Row);
+    header.rowCount = rows.size();
+
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(rows.data()), static_cast<std::streamsize>(rows.size() * sizeof(Row)));
+        out.flush();
+        if (!out)
+            return false;
+    }
+
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
@@ -0,0 +1,86 @@
+/*
+
+    UnitCache.hpp
+
+    Include file for the cache of the measures of units by their content
+
+*/
+
+#ifndef UNITCACHE_HPP
+#define UNITCACHE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+#include "MappedFile.hpp"
+
+class UnitCache {
+public:
+    // measures of a unit, found by the hash of its start tag, and
+    // checked by the hash and length of its bytes
+    struct Row {
+        std::uint64_t tagHash = 0;
+        std::uint64_t hash = 0;
+        std::int64_t length = 0;
+        srcFactsParser::UnitCounts counts = {};
+    };
+
+private:
+    // start of the file, which is followed by the rows sorted by the hash of the start tag
+    struct Header {
+        char magic[8];
+        std::uint32_t measureCount;
+        std::uint32_t rowSize;
+        std::uint64_t rowCount;
+    };
+
+    std::unique_ptr<MappedFile> file;
+    const Row* table = nullptr;
+    std::size_t tableSize = 0;
+    std::vector<Row> rows;
+
+public:
+    /*
+        Hashes the bytes of a unit, 32 bytes at a time in four lanes,
+        as in XXH64
+        Input: Bytes of the unit
+        Output: 64-bit hash
+    */
+    static std::uint64_t hash(std::string_view bytes);
+
+    /*
+        Maps a cache file, with its rows used in place
+        Input: Path of the cache file
+        Output: Mapped rows; bool value for whether it is a cache of this version
+    */
+    bool load(const std::string &path);
+
+    /*
+        Finds the measures of an unchanged unit in the mapped rows, i.e.,
+        one with the hash of its start tag whose bytes have the hash
+        and length of the row
+        Input: Hash of the start tag, and the document from the start of the unit
+        Output: Row of the unit, or nullptr if it is not in the cache
+    */
+    const Row* find(std::uint64_t tagHash, std::string_view unit) const;
+
+    /*
+        Adds a row to write with save
+        Input: Row of a unit
+        Output: N/A
+    */
+    void add(const Row &row);
+
+    /*
+        Writes the added rows sorted by the hash of the start tag, to a
+        temporary file renamed over the cache, so the mapped rows stay valid
+        Input: Path of the cache file
+        Output: Cache file; bool value for whether it was written
+    */
+    bool save(const std::string &path);
+};
+
+#endif
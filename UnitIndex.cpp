@@ -0,0 +1,157 @@
+/*
+
+    UnitIndex.cpp
+
+    Implementation file for the side-car index of the units of a srcML archive
+
+*/
+
+#include "UnitIndex.hpp"
+#include "UnitTable.hpp"
+#include "UnitCache.hpp"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+
+using namespace std::literals::string_view_literals;
+
+// first line of an index, with the version of its format
+const std::string_view INDEX_HEADER = "srcFacts unit index 2"sv;
+
+/*
+    Constructor from the parse of a whole srcML archive in memory
+    The counts of a unit are of its own bytes, from the offset of its
+    start tag to the '>' of its end tag
+    Input: The document, and the handler it was parsed with
+    Output: Index of the child units of the archive
+*/
+UnitIndex::UnitIndex(std::string_view document, srcFactsParser &handler)
+    : documentSize(static_cast<std::int64_t>(document.size()))
+{
+    if (!handler.getIsArchive())
+        return;
+    UnitTable table;
+    table.add(handler);
+
+    // the last unit ends at the end tag of the archive
+    const char* const documentEnd = document.data() + document.size();
+    const char* const archiveEnd = document.data() + std::min(document.size(), document.rfind("</"sv));
+    for (std::size_t unit = 0; unit < table.size(); ++unit) {
+        const char* const tag = table.tags[unit];
+        if (tag < document.data() || tag >= documentEnd)
+            continue;
+
+        // to the '>' of the end tag, without the space before the next unit
+        const char* unitEnd = unit + 1 < table.size() ? table.tags[unit + 1] : std::max(archiveEnd, tag);
+        while (unitEnd > tag && isspace(static_cast<unsigned char>(unitEnd[-1])))
+            --unitEnd;
+
+        Entry entry;
+        entry.offset = std::distance(document.data(), tag);
+        entry.length = std::distance(tag, unitEnd);
+        entry.hash = UnitCache::hash(std::string_view(tag, entry.length));
+        entry.filename = table.filenames[unit];
+        entry.url = table.urls[unit];
+        for (int measure = 0; measure < srcFactsParser::UNIT_MEASURES; ++measure)
+            entry.counts[measure] = table.counts[measure][unit];
+        entries.push_back(std::move(entry));
+    }
+}
+
+/*
+    Writes the index as text, with a line for each unit
+    Input: Path of the index file
+    Output: Index file; bool value for whether it was written
+*/
+bool UnitIndex::save(const std::string &path) const {
+    std::ofstream out(path, std::ios::trunc);
+    out << INDEX_HEADER << '\n' << documentSize << ' ' << entries.size() << '\n';
+    // tab separated, with the names last, since they may have spaces
+    for (const auto& entry : entries) {
+        out << entry.offset << '\t' << entry.length << '\t' << entry.hash;
+        for (const auto count : entry.counts)
+            out << '\t' << count;
+        out << '\t' << entry.filename << '\t' << entry.url << '\n';
+    }
+    out.flush();
+
+    return static_cast<bool>(out);
+}
+
+/*
+    Reads an index written by save
+    Input: Path of the index file
+    Output: Index; bool value for whether it was read
+*/
+bool UnitIndex::load(const std::string &path) {
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line) || line != INDEX_HEADER)
+        return false;
+
+    std::int64_t size = 0;
+    std::size_t entryCount = 0;
+    in >> size >> entryCount;
+    in.ignore(1);
+    std::vector<Entry> loaded;
+    while (loaded.size() < entryCount && std::getline(in, line)) {
+        Entry entry;
+        std::istringstream fields(line);
+        fields >> entry.offset >> entry.length >> entry.hash;
+        for (auto& count : entry.counts)
+            fields >> count;
+        fields.ignore(1);
+        std::getline(fields, entry.filename, '\t');
+        std::getline(fields, entry.url);
+        if (!fields && !fields.eof())
+            return false;
+        loaded.push_back(std::move(entry));
+    }
+    if (loaded.size() != entryCount)
+        return false;
+    documentSize = size;
+    entries = std::move(loaded);
+
+    return true;
+}
+
+/*
+    Whether this is an index of the document, by its size, the unit
+    start tags at the offsets of the entries, and the hash of the
+    bytes of each unit whose filename starts with a prefix, so only
+    the selected units are read
+    Input: The document, and the filename prefix of the selected units
+    Output: Whether the index matches the document
+*/
+bool UnitIndex::matches(std::string_view document, std::string_view filenamePrefix) const {
+    if (documentSize != static_cast<std::int64_t>(document.size()))
+        return false;
+
+    return std::all_of(entries.begin(), entries.end(), [document, filenamePrefix](const Entry& entry) {
+        if (entry.offset < 0 || entry.length <= 0 || entry.offset + entry.length > static_cast<std::int64_t>(document.size())
+            || document[entry.offset] != '<' || document[entry.offset + entry.length - 1] != '>')
+            return false;
+
+        return entry.filename.compare(0, filenamePrefix.size(), filenamePrefix) != 0
+            || entry.hash == UnitCache::hash(document.substr(entry.offset, entry.length));
+    });
+}
+
+/*
+    Get method for the size of the indexed document
+    Input: N/A
+    Output: Size in bytes
+*/
+std::int64_t UnitIndex::getDocumentSize() const {
+    return documentSize;
+}
+
+/*
+    Get method for the units, in document order
+    Input: N/A
+    Output: Entry of each unit
+*/
+const std::vector<UnitIndex::Entry>& UnitIndex::getEntries() const {
+    return entries;
+}
@@ -0,0 +1,91 @@
+/*
+
+    UnitIndex.hpp
+
+    Include file for the side-car index of the units of a srcML archive
+
+*/
+
+#ifndef UNITINDEX_HPP
+#define UNITINDEX_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+
+class UnitIndex {
+public:
+    // a child unit of the archive, with the measures of the report for it
+    struct Entry {
+        std::int64_t offset = 0;
+        std::int64_t length = 0;
+        // of the bytes of the unit, so a changed unit of the same length is not parsed from the index
+        std::uint64_t hash = 0;
+        std::string filename;
+        std::string url;
+        srcFactsParser::UnitCounts counts = {};
+    };
+
+private:
+    std::int64_t documentSize = 0;
+    std::vector<Entry> entries;
+
+public:
+    /*
+        Default Constructor
+        Input: N/A
+        Output: Empty index
+    */
+    UnitIndex() = default;
+
+    /*
+        Constructor from the parse of a whole srcML archive in memory
+        The counts of a unit are of its own bytes, from the offset of its
+        start tag to the '>' of its end tag
+        Input: The document, and the handler it was parsed with
+        Output: Index of the child units of the archive
+    */
+    UnitIndex(std::string_view document, srcFactsParser &handler);
+
+    /*
+        Writes the index as text, with a line for each unit
+        Input: Path of the index file
+        Output: Index file; bool value for whether it was written
+    */
+    bool save(const std::string &path) const;
+
+    /*
+        Reads an index written by save
+        Input: Path of the index file
+        Output: Index; bool value for whether it was read
+    */
+    bool load(const std::string &path);
+
+    /*
+        Whether this is an index of the document, by its size, the unit
+        start tags at the offsets of the entries, and the hash of the
+        bytes of each unit whose filename starts with a prefix, so only
+        the selected units are read
+        Input: The document, and the filename prefix of the selected units
+        Output: Whether the index matches the document
+    */
+    bool matches(std::string_view document, std::string_view filenamePrefix) const;
+
+    /*
+        Get method for the size of the indexed document
+        Input: N/A
+        Output: Size in bytes
+    */
+    std::int64_t getDocumentSize() const;
+
+    /*
+        Get method for the units, in document order
+        Input: N/A
+        Output: Entry of each unit
+    */
+    const std::vector<Entry>& getEntries() const;
+};
+
+#endif
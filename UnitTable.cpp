@@ -0,0 +1,81 @@
+/*
+
+    UnitTable.cpp
+
+    Implementation file for the measures of each top-level unit, e.g., each
+    file of a srcML archive
+
+*/
+
+#include "UnitTable.hpp"
+#include <algorithm>
+
+/*
+    Adds the top-level units of a parse: the child units of an archive,
+    or the root unit of any other document. The counts of a child unit
+    run to the start of the next one, without the characters directly
+    in the root element, e.g., the space between the units
+    Input: Handler of the parse
+    Output: Rows of the units
+*/
+void UnitTable::add(srcFactsParser &handler) {
+    const srcFactsParser::UnitStarts& units = handler.getUnits();
+    const int depth = handler.getIsArchive() ? 1 : 0;
+    std::vector<std::size_t> rows;
+    for (std::size_t unit = 0; unit < units.depths.size(); ++unit) {
+        if (units.depths[unit] == depth)
+            rows.push_back(unit);
+    }
+
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const std::size_t unit = rows[i];
+        tags.push_back(units.tags[unit]);
+        filenames.push_back(units.filenames[unit]);
+        urls.push_back(units.urls[unit]);
+
+        // languages by name, since IDs differ between handlers
+        const std::string& language = units.languageNames[units.languages[unit]];
+        const auto found = std::find(languageNames.begin(), languageNames.end(), language);
+        languages.push_back(static_cast<int>(std::distance(languageNames.begin(), found)));
+        if (found == languageNames.end())
+            languageNames.push_back(language);
+    }
+
+    // a column at a time, to the start of the next unit, or the end of the document,
+    // where the root unit of a document that is not an archive has all of its characters
+    const srcFactsParser::UnitCounts total = depth == 1 ? handler.getChildUnitCounts() : handler.getUnitCounts();
+    for (int measure = 0; measure < srcFactsParser::UNIT_MEASURES; ++measure) {
+        const std::vector<std::int64_t>& before = units.before[measure];
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            const std::int64_t after = i + 1 < rows.size() ? before[rows[i + 1]] : total[measure];
+            counts[measure].push_back(after - before[rows[i]]);
+        }
+    }
+
+    return;
+}
+
+/*
+    Number of units
+    Input: N/A
+    Output: Number of rows
+*/
+std::size_t UnitTable::size() const {
+    return tags.size();
+}
+
+/*
+    Totals of the units of each language
+    Input: N/A
+    Output: Counts of each UnitMeasure, indexed by the ID of the language
+*/
+std::vector<srcFactsParser::UnitCounts> UnitTable::languageTotals() const {
+    std::vector<srcFactsParser::UnitCounts> totals(languageNames.size(), srcFactsParser::UnitCounts{});
+    for (int measure = 0; measure < srcFactsParser::UNIT_MEASURES; ++measure) {
+        const std::vector<std::int64_t>& column = counts[measure];
+        for (std::size_t unit = 0; unit < column.size(); ++unit)
+            totals[languages[unit]][measure] += column[unit];
+    }
+
+    return totals;
+}
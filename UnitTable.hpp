@@ -0,0 +1,56 @@
+/*
+
+    UnitTable.hpp
+
+    Include file for the measures of each top-level unit, e.g., each
+    file of a srcML archive
+
+*/
+
+#ifndef UNITTABLE_HPP
+#define UNITTABLE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+
+// a struct of arrays, so a column of every unit is contiguous
+struct UnitTable {
+    // in the parsed document, e.g., a MappedFile
+    std::vector<const char*> tags;
+    std::vector<std::string> filenames;
+    std::vector<std::string> urls;
+    // ID of the language attribute, an index into languageNames
+    std::vector<int> languages;
+    std::array<std::vector<std::int64_t>, srcFactsParser::UNIT_MEASURES> counts;
+    std::vector<std::string> languageNames;
+
+    /*
+        Adds the top-level units of a parse: the child units of an archive,
+        or the root unit of any other document. The counts of a child unit
+        run to the start of the next one, without the characters directly
+        in the root element, e.g., the space between the units
+        Input: Handler of the parse
+        Output: Rows of the units
+    */
+    void add(srcFactsParser &handler);
+
+    /*
+        Number of units
+        Input: N/A
+        Output: Number of rows
+    */
+    std::size_t size() const;
+
+    /*
+        Totals of the units of each language
+        Input: N/A
+        Output: Counts of each UnitMeasure, indexed by the ID of the language
+    */
+    std::vector<srcFactsParser::UnitCounts> languageTotals() const;
+};
+
+#endif
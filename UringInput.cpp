@@ -0,0 +1,399 @@
+/*
+
+    UringInput.cpp
+
+    Implementation file for XML parser input that keeps several reads
+    outstanding with io_uring
+
+*/
+
+#include "UringInput.hpp"
+#include <algorithm>
+#include <errno.h>
+
+#if !defined(_MSC_VER)
+#include <unistd.h>
+#define READ read
+#else
+#include <BaseTsd.h>
+#include <io.h>
+typedef SSIZE_T ssize_t;
+#define READ _read
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <cstring>
+#endif
+
+// zero bytes after the data of each block so lookahead stays in bounds
+const size_t BLOCK_PADDING = 16;
+
+// starting room in front of the data of each block, grown for a longer token
+const size_t FRONT_SIZE = 4096;
+
+// user data of cancel requests, distinct from any block index
+const unsigned long long CANCEL_DATA = ~0ULL;
+
+/*
+    Constructor that sets up the ring and starts the first reads
+    Falls back to plain read() if io_uring is unavailable
+    Input: File descriptor, size of each buffer, and number of buffers
+    Output: Reads in flight
+*/
+UringInput::UringInput(int inputFD, size_t inputBlockSize, int blockCount)
+    : fd(inputFD), blockSize(inputBlockSize), blocks(std::max(blockCount, 2))
+{
+    // each block has room in front of the data for the unprocessed tail
+    // of the previous block, so a token that straddles blocks is contiguous,
+    // and is not initialized, so a small input only touches what it reads
+    for (auto& block : blocks) {
+        block.front = std::min(FRONT_SIZE, blockSize);
+        block.data.reset(new char[block.front + blockSize + BLOCK_PADDING]);
+    }
+
+#if !defined(_MSC_VER)
+    // reads of a regular file can be at explicit offsets and all in flight at once,
+    // while reads of a pipe complete in order only one at a time
+    const off_t position = lseek(fd, 0, SEEK_CUR);
+    seekable = position != -1;
+    if (seekable)
+        nextOffset = position;
+#endif
+
+    if (!setupRing(static_cast<unsigned>(blocks.size() * 2)))
+        return;
+
+    const int inFlight = seekable ? static_cast<int>(blocks.size()) : 1;
+    for (int i = 0; i < inFlight; ++i) {
+        blocks[i].offset = nextOffset;
+        nextOffset += blockSize;
+        submitRead(i);
+    }
+}
+
+/*
+    Destructor that cancels outstanding reads and closes the ring
+    Input: N/A
+    Output: N/A
+*/
+UringInput::~UringInput() {
+#ifdef HAVE_IO_URING
+    if (ringFD == -1)
+        return;
+
+    // the kernel may still write into the buffers until every read completes
+    eof = true;
+    auto sqes = static_cast<io_uring_sqe*>(sqEntries);
+    for (int i = 0; i < static_cast<int>(blocks.size()); ++i) {
+        if (!blocks[i].inFlight)
+            continue;
+        const unsigned tail = *sqTail;
+        const unsigned entry = tail & *sqMask;
+        std::memset(&sqes[entry], 0, sizeof(io_uring_sqe));
+        sqes[entry].opcode = IORING_OP_ASYNC_CANCEL;
+        sqes[entry].addr = static_cast<unsigned long long>(i);
+        sqes[entry].user_data = CANCEL_DATA;
+        sqArray[entry] = entry;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++toSubmit;
+    }
+    while (std::any_of(blocks.begin(), blocks.end(), [](const Block& block) { return block.inFlight; }))
+        reapCompletions();
+    closeRing();
+#endif
+}
+
+/*
+    Creates the ring and registers the buffers and file
+    Input: Number of ring entries
+    Output: Bool value for if io_uring is usable
+*/
+bool UringInput::setupRing(unsigned entries) {
+#ifdef HAVE_IO_URING
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    const int ring = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ring < 0)
+        return false;
+    ringFD = ring;
+
+    // map the submission queue, completion queue, and submission entries
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap)
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        closeRing();
+        return false;
+    }
+    cqRing = sqRing;
+    if (!singleMap) {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            closeRing();
+            return false;
+        }
+    }
+    sqEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqEntries = mmap(nullptr, sqEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQES);
+    if (sqEntries == MAP_FAILED) {
+        sqEntries = nullptr;
+        closeRing();
+        return false;
+    }
+    char* sq = static_cast<char*>(sqRing);
+    sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(cqRing);
+    cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqEntries = cq + params.cq_off.cqes;
+
+    // registered buffers and file avoid pinning pages and looking up the file on every read
+    std::vector<iovec> iovecs(blocks.size());
+    for (int i = 0; i < static_cast<int>(blocks.size()); ++i) {
+        iovecs[i].iov_base = blocks[i].data.get();
+        iovecs[i].iov_len = blocks[i].front + blockSize + BLOCK_PADDING;
+    }
+    fixedBuffers = syscall(__NR_io_uring_register, ringFD, IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+    for (auto& block : blocks)
+        block.registered = fixedBuffers;
+    fixedFile = syscall(__NR_io_uring_register, ringFD, IORING_REGISTER_FILES, &fd, 1) == 0;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+    Unmaps and closes the ring
+    Input: N/A
+    Output: N/A
+*/
+void UringInput::closeRing() {
+#ifdef HAVE_IO_URING
+    if (sqEntries)
+        munmap(sqEntries, sqEntriesSize);
+    if (cqRing && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing)
+        munmap(sqRing, sqRingSize);
+    close(ringFD);
+    ringFD = -1;
+#endif
+}
+
+/*
+    Queues and submits a read into the unfilled part of a block
+    Input: Index of the block
+    Output: N/A
+*/
+void UringInput::submitRead(int index) {
+#ifdef HAVE_IO_URING
+    Block& block = blocks[index];
+    auto sqes = static_cast<io_uring_sqe*>(sqEntries);
+    const unsigned tail = *sqTail;
+    const unsigned entry = tail & *sqMask;
+    io_uring_sqe& sqe = sqes[entry];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = block.registered ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    sqe.fd = fixedFile ? 0 : fd;
+    if (fixedFile)
+        sqe.flags = IOSQE_FIXED_FILE;
+    sqe.off = seekable ? static_cast<unsigned long long>(block.offset + block.size) : ~0ULL;
+    sqe.addr = reinterpret_cast<unsigned long long>(block.data.get() + block.front + block.size);
+    sqe.len = static_cast<unsigned>(blockSize - block.size);
+    if (block.registered)
+        sqe.buf_index = static_cast<unsigned short>(index);
+    sqe.user_data = static_cast<unsigned long long>(index);
+    sqArray[entry] = entry;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    block.inFlight = true;
+    ++toSubmit;
+
+    long submitted = 0;
+    while ((submitted = syscall(__NR_io_uring_enter, ringFD, toSubmit, 0, 0, nullptr, 0)) == -1 && errno == EINTR) {
+    }
+    if (submitted > 0)
+        toSubmit -= static_cast<unsigned>(submitted);
+#endif
+}
+
+/*
+    Waits for at least one completion and records the results
+    Input: N/A
+    Output: Updated block states
+*/
+void UringInput::reapCompletions() {
+#ifdef HAVE_IO_URING
+    long submitted = 0;
+    while ((submitted = syscall(__NR_io_uring_enter, ringFD, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0)) == -1 && errno == EINTR) {
+    }
+    if (submitted == -1) {
+        // ring is unusable, so fail every outstanding read
+        for (auto& block : blocks) {
+            if (block.inFlight) {
+                block.inFlight = false;
+                block.done = true;
+                block.size = -1;
+            }
+        }
+        return;
+    }
+    toSubmit -= static_cast<unsigned>(submitted);
+
+    std::vector<int> resubmit;
+    unsigned head = *cqHead;
+    const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    auto cqes = static_cast<io_uring_cqe*>(cqEntries);
+    for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = cqes[head & *cqMask];
+        if (cqe.user_data == CANCEL_DATA)
+            continue;
+        Block& block = blocks[cqe.user_data];
+        block.inFlight = false;
+        if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+            resubmit.push_back(static_cast<int>(cqe.user_data));
+        } else if (cqe.res < 0) {
+            block.size = -1;
+            block.done = true;
+        } else if (cqe.res == 0) {
+            // EOF
+            block.done = true;
+        } else {
+            // a short read is continued into the rest of the block
+            block.size += cqe.res;
+            if (block.size < static_cast<long>(blockSize))
+                resubmit.push_back(static_cast<int>(cqe.user_data));
+            else
+                block.done = true;
+        }
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+    for (const int index : resubmit) {
+        if (eof)
+            blocks[index].done = true;
+        else
+            submitRead(index);
+    }
+#endif
+}
+
+/*
+    Fills a block with a plain read(), used when io_uring is unavailable
+    Input: Index of the block
+    Output: Updated block state
+*/
+void UringInput::readBlock(int index) {
+    Block& block = blocks[index];
+    ssize_t readBytes = 0;
+    while (((readBytes = READ(fd, static_cast<void*>(block.data.get() + block.front), blockSize)) == -1) && (errno == EINTR)) {
+    }
+    block.size = static_cast<long>(readBytes);
+    block.done = true;
+}
+
+/*
+    Grows the room in front of the data of a completed block, moving its
+    data, so the unprocessed content of the previous block fits. The moved
+    block is no longer a registered buffer.
+    Input: Block and the number of unprocessed characters
+    Output: Block with at least that much room in front of its data
+*/
+void UringInput::growFront(Block& block, size_t unprocessed) {
+    size_t front = block.front;
+    while (front < unprocessed)
+        front *= 2;
+    front = std::min(front, blockSize);
+
+    std::unique_ptr<char[]> data(new char[front + blockSize + BLOCK_PADDING]);
+    std::copy_n(block.data.get() + block.front, std::max(block.size, 0L), data.get() + front);
+    block.data = std::move(data);
+    block.front = front;
+    block.registered = false;
+}
+
+/*
+    Returns if reads are done with io_uring, instead of the read() fallback
+    Input: N/A
+    Output: Bool value for if io_uring is in use
+*/
+bool UringInput::isUring() const {
+    return ringFD != -1;
+}
+
+/*
+    Moves to the next completed buffer, stitching the unprocessed
+    content of the current buffer in front of the new data
+    Input: Start and end iterators of unprocessed segment by ref
+    Output: Number of bytes read, 0 at EOF, -1 on read error; adjusted iterators by ref
+*/
+int UringInput::refill(const char* &cursor, const char* &cursorEnd) {
+
+    // number of unprocessed characters [cursor, cursorEnd)
+    const size_t unprocessed = std::distance(cursor, cursorEnd);
+    if (unprocessed > blockSize)
+        return -1;
+
+    // after EOF or error there are no more blocks, and the unprocessed content stays
+    if (current != -1 && blocks[current].size <= 0)
+        return static_cast<int>(blocks[current].size);
+
+    // wait for the next block in file order
+    const int next = (current + 1) % static_cast<int>(blocks.size());
+    Block& block = blocks[next];
+    if (ringFD == -1) {
+        readBlock(next);
+    } else if (!block.inFlight && !block.done) {
+        // no read was started after EOF
+        block.size = 0;
+        block.done = true;
+    } else {
+        while (!block.done)
+            reapCompletions();
+    }
+
+    // move unprocessed characters in front of the new data
+    if (unprocessed > block.front)
+        growFront(block, unprocessed);
+    char* data = block.data.get() + block.front;
+    std::copy(cursor, cursorEnd, data - unprocessed);
+    std::fill_n(data + std::max(block.size, 0L), BLOCK_PADDING, '\0');
+    if (block.size < static_cast<long>(blockSize))
+        eof = true;
+    if (current != -1)
+        blocks[current].done = false;
+
+    // reuse the released block for the read after all those in flight
+    if (ringFD != -1 && !eof) {
+        const int reuse = seekable ? current : (next + 1) % static_cast<int>(blocks.size());
+        if (reuse != -1) {
+            blocks[reuse].size = 0;
+            blocks[reuse].done = false;
+            blocks[reuse].offset = nextOffset;
+            nextOffset += blockSize;
+            submitRead(reuse);
+        }
+    }
+    current = next;
+
+    // at EOF or read error, only the unprocessed characters
+    cursor = data - unprocessed;
+    cursorEnd = data + std::max(block.size, 0L);
+
+    return static_cast<int>(block.size);
+}
@@ -0,0 +1,137 @@
+/*
+
+    UringInput.hpp
+
+    Include file for XML parser input that keeps several reads
+    outstanding with io_uring
+
+*/
+
+#ifndef URINGINPUT_HPP
+#define URINGINPUT_HPP
+
+#include "XMLParserInput.hpp"
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+class UringInput : public XMLParserInput {
+private:
+    /*
+        Creates the ring and registers the buffers and file
+        Input: Number of ring entries
+        Output: Bool value for if io_uring is usable
+    */
+    bool setupRing(unsigned entries);
+
+    /*
+        Unmaps and closes the ring
+        Input: N/A
+        Output: N/A
+    */
+    void closeRing();
+
+    /*
+        Queues and submits a read into the unfilled part of a block
+        Input: Index of the block
+        Output: N/A
+    */
+    void submitRead(int index);
+
+    /*
+        Waits for at least one completion and records the results
+        Input: N/A
+        Output: Updated block states
+    */
+    void reapCompletions();
+
+    /*
+        Fills a block with a plain read(), used when io_uring is unavailable
+        Input: Index of the block
+        Output: Updated block state
+    */
+    void readBlock(int index);
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t front = 0;
+        bool registered = false;
+        long size = 0;
+        long long offset = 0;
+        bool inFlight = false;
+        bool done = false;
+    };
+
+    /*
+        Grows the room in front of the data of a completed block, moving its
+        data, so the unprocessed content of the previous block fits. The moved
+        block is no longer a registered buffer.
+        Input: Block and the number of unprocessed characters
+        Output: Block with at least that much room in front of its data
+    */
+    void growFront(Block& block, size_t unprocessed);
+
+    int fd;
+    size_t blockSize;
+    std::vector<Block> blocks;
+    int current = -1;
+    bool seekable = false;
+    bool eof = false;
+    long long nextOffset = 0;
+
+    // io_uring state
+    int ringFD = -1;
+    unsigned toSubmit = 0;
+    bool fixedFile = false;
+    bool fixedBuffers = false;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    void* sqEntries = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    size_t sqEntriesSize = 0;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    void* cqEntries = nullptr;
+
+public:
+    /*
+        Constructor that sets up the ring and starts the first reads
+        Falls back to plain read() if io_uring is unavailable
+        Input: File descriptor, size of each buffer, and number of buffers
+        Output: Reads in flight
+    */
+    UringInput(int inputFD = 0, size_t inputBlockSize = 4 * 1024 * 1024, int blockCount = 4);
+
+    /*
+        Destructor that cancels outstanding reads and closes the ring
+        Input: N/A
+        Output: N/A
+    */
+    ~UringInput() override;
+
+    UringInput(const UringInput&) = delete;
+    UringInput& operator=(const UringInput&) = delete;
+
+    /*
+        Returns if reads are done with io_uring, instead of the read() fallback
+        Input: N/A
+        Output: Bool value for if io_uring is in use
+    */
+    bool isUring() const;
+
+    /*
+        Moves to the next completed buffer, stitching the unprocessed
+        content of the current buffer in front of the new data
+        Input: Start and end iterators of unprocessed segment by ref
+        Output: Number of bytes read, 0 at EOF, -1 on read error; adjusted iterators by ref
+    */
+    int refill(const char* &cursor, const char* &cursorEnd) override;
+};
+
+#endif
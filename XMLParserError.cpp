@@ -0,0 +1,60 @@
+/*
+
+    XMLParserError.cpp
+
+    Implementation file for the error that stops a parse, with its position
+
+*/
+
+#include "XMLParserError.hpp"
+#include <algorithm>
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+/*
+    Description of the error code
+    Input: N/A
+    Output: Message, e.g., "Unterminated CDATA"
+*/
+std::string_view XMLParserError::message() const {
+    switch (code) {
+    case NONE:                                return "No error"sv;
+    case INPUT_ERROR:                         return "File input error"sv;
+    case INCOMPLETE_NAMESPACE:                return "Incomplete namespace"sv;
+    case EMPTY_ATTRIBUTE_NAME:                return "Empty attribute name"sv;
+    case INVALID_ATTRIBUTE_NAME:              return "Invalid attribute name"sv;
+    case INCOMPLETE_ATTRIBUTE:                return "Incomplete attribute"sv;
+    case MISSING_ATTRIBUTE_EQUALS:            return "Attribute missing ="sv;
+    case MISSING_ATTRIBUTE_DELIMITER:         return "Attribute missing delimiter"sv;
+    case UNTERMINATED_XML_COMMENT:            return "Unterminated XML comment"sv;
+    case UNTERMINATED_CDATA:                  return "Unterminated CDATA"sv;
+    case INCOMPLETE_XML_DECLARATION:          return "Incomplete XML declaration"sv;
+    case INVALID_XML_DECLARATION:             return "Invalid XML declaration"sv;
+    case INCOMPLETE_PROCESSING_INSTRUCTION:   return "Incomplete processing instruction"sv;
+    case UNTERMINATED_PROCESSING_INSTRUCTION: return "Unterminated processing instruction"sv;
+    case INCOMPLETE_END_TAG:                  return "Incomplete element end tag"sv;
+    case INVALID_END_TAG_NAME:                return "Invalid end tag name"sv;
+    case UNTERMINATED_END_TAG:                return "Unterminated end tag"sv;
+    case INCOMPLETE_START_TAG:                return "Incomplete element start tag"sv;
+    case INVALID_START_TAG_NAME:              return "Invalid start tag name"sv;
+    case UNTERMINATED_START_TAG:              return "Unterminated start tag"sv;
+    case UNTERMINATED_ELEMENT:                return "Unterminated element"sv;
+    case CHARACTERS_OUTSIDE_ROOT:             return "Characters outside of the root element"sv;
+    }
+
+    return "Unknown error"sv;
+}
+
+/*
+    Sets the position of the error from its offset in a document in memory
+    Input: The document and the byte offset of the error in it
+    Output: Updated offset, line, and column
+*/
+void XMLParserError::locate(std::string_view document, std::int64_t errorOffset) {
+    offset = errorOffset;
+    const std::string_view before = document.substr(0, static_cast<std::size_t>(errorOffset));
+    line = std::count(before.begin(), before.end(), '\n') + 1;
+    const auto lineStart = before.rfind('\n');
+    column = static_cast<std::int64_t>(before.size() - (lineStart == std::string_view::npos ? 0 : lineStart + 1)) + 1;
+}
@@ -0,0 +1,75 @@
+/*
+
+    XMLParserError.hpp
+
+    Include file for the error that stops a parse, with its position
+
+*/
+
+#ifndef XMLPARSERERROR_HPP
+#define XMLPARSERERROR_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct XMLParserError {
+    // kind of malformed construct, or of input failure
+    enum Code {
+        NONE,
+        INPUT_ERROR,
+        INCOMPLETE_NAMESPACE,
+        EMPTY_ATTRIBUTE_NAME,
+        INVALID_ATTRIBUTE_NAME,
+        INCOMPLETE_ATTRIBUTE,
+        MISSING_ATTRIBUTE_EQUALS,
+        MISSING_ATTRIBUTE_DELIMITER,
+        UNTERMINATED_XML_COMMENT,
+        UNTERMINATED_CDATA,
+        INCOMPLETE_XML_DECLARATION,
+        INVALID_XML_DECLARATION,
+        INCOMPLETE_PROCESSING_INSTRUCTION,
+        UNTERMINATED_PROCESSING_INSTRUCTION,
+        INCOMPLETE_END_TAG,
+        INVALID_END_TAG_NAME,
+        UNTERMINATED_END_TAG,
+        INCOMPLETE_START_TAG,
+        INVALID_START_TAG_NAME,
+        UNTERMINATED_START_TAG,
+        UNTERMINATED_ELEMENT,
+        CHARACTERS_OUTSIDE_ROOT
+    };
+
+    Code code = NONE;
+
+    // byte offset from the start of the document, and its line and column, from 1
+    std::int64_t offset = 0;
+    std::int64_t line = 0;
+    std::int64_t column = 0;
+
+    // description of an input error from the input, e.g., of its decompressor, or empty
+    std::string detail;
+
+    /*
+        Whether there is an error
+        Input: N/A
+        Output: Whether the code is not NONE
+    */
+    explicit operator bool() const { return code != NONE; }
+
+    /*
+        Description of the error code
+        Input: N/A
+        Output: Message, e.g., "Unterminated CDATA"
+    */
+    std::string_view message() const;
+
+    /*
+        Sets the position of the error from its offset in a document in memory
+        Input: The document and the byte offset of the error in it
+        Output: Updated offset, line, and column
+    */
+    void locate(std::string_view document, std::int64_t errorOffset);
+};
+
+#endif
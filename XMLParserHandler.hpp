@@ -14,6 +14,28 @@
 
 class XMLParserHandler {
 public:
+    // events of a handler, for its eventMask
+    enum Event : unsigned int {
+        START_DOCUMENT = 1 << 0,
+        XML_DECLARATION = 1 << 1,
+        START_TAG = 1 << 2,
+        END_TAG = 1 << 3,
+        CHARACTERS = 1 << 4,
+        ATTRIBUTE = 1 << 5,
+        XML_NAMESPACE = 1 << 6,
+        XML_COMMENT = 1 << 7,
+        CDATA = 1 << 8,
+        PROCESSING_INSTRUCTION = 1 << 9,
+        END_DOCUMENT = 1 << 10,
+        ALL_EVENTS = (1 << 11) - 1
+    };
+
+    /*
+        Events the handler is called for. A handler class can redeclare
+        it with fewer events, so that BasicXMLParser skips the others
+    */
+    static constexpr unsigned int eventMask = ALL_EVENTS;
+
     /*
         Virtual function that handles
         starting the document
@@ -49,10 +71,10 @@ public:
     /*
         Virtual function that handles
         characters
-        Input: std::string_view characters, int depth
+        Input: std::string_view characters, int newlineCount, int depth
         Output: N/A
     */
-    virtual void handleCharacters(std::string_view characters, const int &depth) = 0;
+    virtual void handleCharacters(std::string_view characters, const int &newlineCount, const int &depth) = 0;
 
     /*
         Virtual function that handles
@@ -0,0 +1,42 @@
+/*
+
+    XMLParserInput.hpp
+
+    Include file for XML parser input source class
+
+*/
+
+#ifndef XMLPARSERINPUT_HPP
+#define XMLPARSERINPUT_HPP
+
+#include <string>
+
+class XMLParserInput {
+public:
+    /*
+        Virtual default destructor
+        Input: N/A
+        Output: N/A
+    */
+    virtual ~XMLParserInput() = default;
+
+    /*
+        Virtual function that refills the input preserving the unused data.
+        On return, the unprocessed content [cursor, cursorEnd) is followed
+        by the new data, and at least 16 readable bytes follow cursorEnd.
+        At EOF, [cursor, cursorEnd) is still the unprocessed content.
+        Input: Start and end iterators of unprocessed segment by ref
+        Output: Number of bytes read, 0 at EOF, -1 on read error; adjusted iterators by ref
+    */
+    virtual int refill(const char* &cursor, const char* &cursorEnd) = 0;
+
+    /*
+        Virtual function that describes the error of a refill that
+        returned -1, by default none past the failed read itself
+        Input: N/A
+        Output: Description of the error, or empty
+    */
+    virtual std::string errorMessage() const { return std::string(); }
+};
+
+#endif
@@ -0,0 +1,204 @@
+/*
+
+    XMLReader.cpp
+
+    Implementation file for the pull XML parsing class
+
+*/
+
+#include "XMLReader.hpp"
+
+template class BasicXMLParser<XMLReader::TokenHandler>;
+
+/*
+    Keeps a token of the current parse step
+    Input: Token
+    Output: Token added, unless all of the slots are used
+*/
+void XMLReader::TokenHandler::keep(const Token &token) {
+    if (count < MAXIMUM_TOKENS)
+        tokens[count++] = token;
+}
+
+/*
+    Keeps the start of the document as a token
+    Input: int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleStartDocument(const int &depth) {
+    keep(Token{ XMLParserHandler::START_DOCUMENT, depth, 0, {}, {}, {}, {} });
+}
+
+/*
+    Keeps an XML declaration as a token
+    Input: std::string_view version, std::optional<std::string_view> encoding, std::optional<std::string_view> standalone, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleXMLDeclaration(std::string_view version, const std::optional<std::string_view> &, const std::optional<std::string_view> &, const int &depth) {
+    keep(Token{ XMLParserHandler::XML_DECLARATION, depth, 0, {}, {}, {}, version });
+}
+
+/*
+    Keeps an element start tag as a token
+    Input: std::string_view qName, std::string_view prefix, std::string_view localName, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleElementStartTag(std::string_view qName, std::string_view prefix, std::string_view localName, const int &depth) {
+    keep(Token{ XMLParserHandler::START_TAG, depth, 0, qName, prefix, localName, {} });
+}
+
+/*
+    Keeps an element end tag as a token
+    Input: std::string_view qName, std::string_view prefix, std::string_view localName, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleElementEndTag(std::string_view qName, std::string_view prefix, std::string_view localName, const int &depth) {
+    keep(Token{ XMLParserHandler::END_TAG, depth, 0, qName, prefix, localName, {} });
+}
+
+/*
+    Keeps characters as a token
+    Input: std::string_view characters, int newlineCount, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleCharacters(std::string_view characters, const int &newlineCount, const int &depth) {
+    keep(Token{ XMLParserHandler::CHARACTERS, depth, newlineCount, {}, {}, {}, characters });
+}
+
+/*
+    Keeps an attribute as a token
+    Input: std::string_view qName, std::string_view prefix, std::string_view localName, std::string_view value, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleAttribute(std::string_view qName, std::string_view prefix, std::string_view localName, std::string_view value, const int &depth) {
+    keep(Token{ XMLParserHandler::ATTRIBUTE, depth, 0, qName, prefix, localName, value });
+}
+
+/*
+    Keeps an XML namespace as a token
+    Input: std::string_view prefix, std::string_view uri, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleXMLNamespace(std::string_view prefix, std::string_view uri, const int &depth) {
+    keep(Token{ XMLParserHandler::XML_NAMESPACE, depth, 0, {}, prefix, {}, uri });
+}
+
+/*
+    Keeps an XML comment as a token
+    Input: std::string_view value, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleXMLComment(std::string_view value, const int &depth) {
+    keep(Token{ XMLParserHandler::XML_COMMENT, depth, 0, {}, {}, {}, value });
+}
+
+/*
+    Keeps CDATA as a token
+    Input: std::string_view content, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleCDATA(std::string_view content, const int &depth) {
+    keep(Token{ XMLParserHandler::CDATA, depth, 0, {}, {}, {}, content });
+}
+
+/*
+    Keeps a processing instruction as a token
+    Input: std::string_view target, std::string_view data, int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleProcessingInstruction(std::string_view target, std::string_view data, const int &depth) {
+    keep(Token{ XMLParserHandler::PROCESSING_INSTRUCTION, depth, 0, {}, {}, target, data });
+}
+
+/*
+    Keeps the end of the document as a token
+    Input: int depth
+    Output: Token
+*/
+void XMLReader::TokenHandler::handleEndDocument(const int &depth) {
+    keep(Token{ XMLParserHandler::END_DOCUMENT, depth, 0, {}, {}, {}, {} });
+}
+
+/*
+    Constructor for a document already in memory, e.g., a MappedFile,
+    or for a fragment of one that starts at the given depth
+    The document must be followed by a readable byte for lookahead
+    Input: The document, and its starting depth
+    Output: Initialized data members
+*/
+XMLReader::XMLReader(std::string_view inputDocument, int inputDepth)
+    : parser(handler, inputDocument, inputDepth)
+{}
+
+/*
+    Constructor for a pluggable input source, e.g., ReadAheadInput
+    Input: XMLParserInput object
+    Output: Initialized data members
+*/
+XMLReader::XMLReader(XMLParserInput &inputSource)
+    : parser(handler, inputSource)
+{}
+
+/*
+    Constructor for standard input, read into a caller-owned buffer
+    Input: Start of the buffer and its size
+    Output: Initialized data members
+*/
+XMLReader::XMLReader(char* inputBuffer, int inputSize)
+    : parser(handler, inputBuffer, inputSize)
+{}
+
+/*
+    Advances to the next token of the document
+    Input: N/A
+    Output: The token, valid until the next call, and
+            END_DOCUMENT at and after the end of the document,
+            or after an error, which getError() returns
+*/
+const XMLReader::Token& XMLReader::next() {
+
+    // a parse step may have left a second token, e.g., after the start of the document
+    if (current + 1 < handler.count)
+        return handler.tokens[++current];
+    if (done)
+        return handler.tokens[current];
+
+    // parse until the next token, as some steps have none, e.g., a buffer refill
+    handler.count = 0;
+    current = 0;
+    while (handler.count == 0) {
+        if (parser.parse())
+            handler.handleEndDocument(parser.getDepth());
+    }
+    done = handler.tokens[handler.count - 1].kind == XMLParserHandler::END_DOCUMENT;
+
+    return handler.tokens[0];
+}
+
+/*
+    Skips the rest of the element of the last START_TAG or ATTRIBUTE
+    token, i.e., its attributes, content, and end tag, with no tokens
+    Input: N/A
+    Output: The next call of next() returns the token after the element
+*/
+void XMLReader::skipElement() {
+    parser.skipElement();
+}
+
+/*
+    Returns the total number of bytes read by the parser
+    Input: N/A
+    Output: Total bytes read as a 64-bit integer
+*/
+std::int64_t XMLReader::getTotalBytes() {
+    return parser.getTotalBytes();
+}
+
+/*
+    Returns the error that ended the document early
+    Input: N/A
+    Output: Error with its position, or NONE
+*/
+const XMLParserError& XMLReader::getError() {
+    return parser.getError();
+}
@@ -0,0 +1,148 @@
+/*
+
+    XMLReader.hpp
+
+    Include file for the pull XML parsing class, where the consumer
+    asks for each token instead of being called for each event
+
+*/
+
+#ifndef XMLREADER_HPP
+#define XMLREADER_HPP
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include "BasicXMLParser.hpp"
+#include "XMLParserHandler.hpp"
+#include "XMLParserInput.hpp"
+
+class XMLReader {
+public:
+    /*
+        Token of an event, with the same fields as the XMLParserHandler
+        callback for the event. The views are valid until the next call
+        of next(). Values by kind:
+        * START_TAG, END_TAG - qName, prefix, and localName
+        * ATTRIBUTE - qName, prefix, localName, and value
+        * XML_NAMESPACE - prefix, and the uri as value
+        * CHARACTERS - value and newlineCount
+        * XML_COMMENT, CDATA - value
+        * PROCESSING_INSTRUCTION - the target as localName, and the data as value
+        * XML_DECLARATION - the version as value
+        As with the callbacks, an empty element has no END_TAG token
+    */
+    struct Token {
+        XMLParserHandler::Event kind = XMLParserHandler::START_DOCUMENT;
+        int depth = 0;
+        int newlineCount = 0;
+        std::string_view qName;
+        std::string_view prefix;
+        std::string_view localName;
+        std::string_view value;
+    };
+
+    // handler that keeps each event as a token for next()
+    class TokenHandler {
+    private:
+        friend class XMLReader;
+
+        // the most a parse step keeps: the start of the document, its first
+        // token, and the end of the document that next() adds for an error
+        static constexpr int MAXIMUM_TOKENS = 3;
+        Token tokens[MAXIMUM_TOKENS];
+        int count = 0;
+
+        /*
+            Keeps a token of the current parse step
+            Input: Token
+            Output: Token added, unless all of the slots are used
+        */
+        void keep(const Token &token);
+
+    public:
+        // parse() returns after each token
+        static constexpr bool pullsEvents = true;
+
+        void handleStartDocument(const int &depth);
+        void handleXMLDeclaration(std::string_view version, const std::optional<std::string_view> &encoding, const std::optional<std::string_view> &standalone, const int &depth);
+        void handleElementStartTag(std::string_view qName, std::string_view prefix, std::string_view localName, const int &depth);
+        void handleElementEndTag(std::string_view qName, std::string_view prefix, std::string_view localName, const int &depth);
+        void handleCharacters(std::string_view characters, const int &newlineCount, const int &depth);
+        void handleAttribute(std::string_view qName, std::string_view prefix, std::string_view localName, std::string_view value, const int &depth);
+        void handleXMLNamespace(std::string_view prefix, std::string_view uri, const int &depth);
+        void handleXMLComment(std::string_view value, const int &depth);
+        void handleCDATA(std::string_view content, const int &depth);
+        void handleProcessingInstruction(std::string_view target, std::string_view data, const int &depth);
+        void handleEndDocument(const int &depth);
+    };
+
+private:
+    TokenHandler handler;
+    BasicXMLParser<TokenHandler> parser;
+    int current = 0;
+    bool done = false;
+
+public:
+    /*
+        Constructor for a document already in memory, e.g., a MappedFile,
+        or for a fragment of one that starts at the given depth
+        The document must be followed by a readable byte for lookahead
+        Input: The document, and its starting depth
+        Output: Initialized data members
+    */
+    XMLReader(std::string_view inputDocument, int inputDepth = 0);
+
+    /*
+        Constructor for a pluggable input source, e.g., ReadAheadInput
+        Input: XMLParserInput object
+        Output: Initialized data members
+    */
+    XMLReader(XMLParserInput &inputSource);
+
+    /*
+        Constructor for standard input, read into a caller-owned buffer
+        Input: Start of the buffer and its size
+        Output: Initialized data members
+    */
+    XMLReader(char* inputBuffer, int inputSize);
+
+    XMLReader(const XMLReader&) = delete;
+    XMLReader& operator=(const XMLReader&) = delete;
+
+    /*
+        Advances to the next token of the document
+        Input: N/A
+        Output: The token, valid until the next call, and
+                END_DOCUMENT at and after the end of the document,
+                or after an error, which getError() returns
+    */
+    const Token& next();
+
+    /*
+        Skips the rest of the element of the last START_TAG or ATTRIBUTE
+        token, i.e., its attributes, content, and end tag, with no tokens
+        Input: N/A
+        Output: The next call of next() returns the token after the element
+    */
+    void skipElement();
+
+    /*
+        Returns the total number of bytes read by the parser
+        Input: N/A
+        Output: Total bytes read as a 64-bit integer
+    */
+    std::int64_t getTotalBytes();
+
+    /*
+        Returns the error that ended the document early
+        Input: N/A
+        Output: Error with its position, or NONE
+    */
+    const XMLParserError& getError();
+};
+
+// parser compiled once, in XMLReader.cpp
+extern template class BasicXMLParser<XMLReader::TokenHandler>;
+
+#endif
@@ -0,0 +1,129 @@
+/*
+    checkpointtest.cpp
+
+    Test of parseCheckpointed against the parse of the whole archive: a
+    run with no checkpoint, and a run resumed from the checkpoint left by
+    a run stopped by an error in the last unit, which has the same
+    measures as a run from the start once the error is fixed.
+
+    Output is a line for each failed check, and the exit status is the
+    number of failed checks.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include "parseCheckpointed.hpp"
+#include "BasicXMLParser.hpp"
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+// checkpoint file of the test, in the current directory
+const std::string CHECKPOINT_PATH = "checkpointtest.checkpoint";
+
+// bytes between checkpoints, for many regions in the archive
+const std::int64_t INTERVAL = 8 * 1024;
+
+namespace {
+
+    /*
+        An archive of units that each have the same text, with space between the units
+
+        @param[in] unitCount Number of units
+        @return The archive
+    */
+    std::string archive(int unitCount) {
+        std::string document = "<?xml version=\"1.0\"?>\n<unit xmlns=\"http://www.srcML.org/srcML/src\">\n\n";
+        for (int unit = 0; unit < unitCount; ++unit)
+            document += "<unit filename=\"f" + std::to_string(unit) + ".cpp\" language=\"C++\"><expr>a\nb\nc\n</expr></unit>\n\n";
+        document += "</unit>\n";
+
+        return document;
+    }
+
+    /*
+        Whether there is a checkpoint file
+
+        @return Whether the checkpoint file can be read
+    */
+    bool hasCheckpoint() {
+        return static_cast<bool>(std::ifstream(CHECKPOINT_PATH));
+    }
+
+    /*
+        Parse a document with checkpoints, and check the measures against
+        the parse of the whole document, and that the checkpoint is removed
+
+        @param[in] name Name of the check
+        @param[in] document The document
+        @return Number of failed checks
+    */
+    int check(std::string_view name, std::string_view document) {
+        srcFactsParser expected;
+        BasicXMLParser<srcFactsParser> parser(expected, document);
+        if (const XMLParserError error = parser.parse())
+            std::cout << name << ": " << error.message() << " in the parse of the whole document\n";
+
+        int failed = 0;
+        srcFactsParser handler;
+        bool saved = false;
+        XMLParserError error;
+        const std::int64_t totalBytes = parseCheckpointed(document, handler, CHECKPOINT_PATH, INTERVAL, saved, error);
+        if (error) {
+            std::cout << name << ": " << error.message() << '\n';
+            ++failed;
+        }
+        if (!saved) {
+            std::cout << name << ": checkpoint not written\n";
+            ++failed;
+        }
+        if (handler.getUnitCounts() != expected.getUnitCounts() || totalBytes != parser.getTotalBytes()) {
+            std::cout << name << ": measures differ from the parse of the whole document\n";
+            ++failed;
+        }
+        if (hasCheckpoint()) {
+            std::cout << name << ": checkpoint not removed\n";
+            ++failed;
+        }
+
+        return failed;
+    }
+}
+
+int main() {
+    int failed = 0;
+
+    // larger than the start of the document that identifies a checkpoint
+    const std::string document = archive(1500);
+    std::remove(CHECKPOINT_PATH.c_str());
+    failed += check("no checkpoint"sv, document);
+
+    // an error in the last unit, of the same size, leaves the checkpoint of the region before it
+    std::string broken = document;
+    broken[broken.rfind("a\nb\nc\n")] = '<';
+    {
+        srcFactsParser expected;
+        const XMLParserError expectedError = BasicXMLParser<srcFactsParser>(expected, std::string_view(broken)).parse();
+        srcFactsParser handler;
+        bool saved = false;
+        XMLParserError error;
+        parseCheckpointed(broken, handler, CHECKPOINT_PATH, INTERVAL, saved, error);
+        if (error.code == XMLParserError::NONE || error.code != expectedError.code || error.offset != expectedError.offset) {
+            std::cout << "stopped run: " << error.message() << " at byte " << error.offset << " instead of "
+                      << expectedError.message() << " at byte " << expectedError.offset << '\n';
+            ++failed;
+        }
+        if (!saved || !hasCheckpoint()) {
+            std::cout << "stopped run: no checkpoint\n";
+            ++failed;
+        }
+    }
+    failed += check("resumed"sv, document);
+
+    std::remove(CHECKPOINT_PATH.c_str());
+
+    return failed;
+}
@@ -0,0 +1,36 @@
+/*
+    findUnits.cpp
+
+    Implementation file for findUnits function
+*/
+
+#include "findUnits.hpp"
+#include "splitUnits.hpp"
+
+/*
+    Find every child unit of a srcML archive, i.e., unit elements at
+    depth 1, with scanUnits, so with no parse of the content. Each unit runs from its start tag to the '>' of its end tag,
+    so the markup between units, e.g., the archive start tag, is outside
+    of every unit. The length of a unit that is already known, e.g., from
+    a cache, skips the scan of its content.
+
+    @param[in] document Complete srcML document
+    @param[in] knownLength Called once for each unit in document order
+               with its start tag, and returns the length of the unit, or 0
+               when it is not known
+    @return Views of each child unit in document order
+    @retval empty Not an archive, or one that ends in a unit
+*/
+std::vector<std::string_view> findUnits(std::string_view document,
+                                        const std::function<std::size_t(std::string_view startTag)>& knownLength) {
+    std::vector<std::string_view> units;
+    const bool valid = scanUnits(document, [&](std::string_view startTag) {
+        return knownLength ? knownLength(startTag) : 0;
+    }, [&](std::string_view unit) {
+        units.push_back(unit);
+    });
+    if (!valid)
+        return std::vector<std::string_view>();
+
+    return units;
+}
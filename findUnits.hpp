@@ -0,0 +1,32 @@
+/*
+    findUnits.hpp
+
+    Include file for the findUnits function
+*/
+
+#ifndef INCLUDED_FINDUNITS_HPP
+#define INCLUDED_FINDUNITS_HPP
+
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/*
+    Find every child unit of a srcML archive, i.e., unit elements at
+    depth 1, with scanUnits, so with no parse of the content. Each unit runs from its start tag to the '>' of its end tag,
+    so the markup between units, e.g., the archive start tag, is outside
+    of every unit. The length of a unit that is already known, e.g., from
+    a cache, skips the scan of its content.
+
+    @param[in] document Complete srcML document
+    @param[in] knownLength Called once for each unit in document order
+               with its start tag, and returns the length of the unit, or 0
+               when it is not known
+    @return Views of each child unit in document order
+    @retval empty Not an archive, or one that ends in a unit
+*/
+std::vector<std::string_view> findUnits(std::string_view document,
+                                        const std::function<std::size_t(std::string_view startTag)>& knownLength = nullptr);
+
+#endif
@@ -0,0 +1,97 @@
+/*
+    parseCached.cpp
+
+    Implementation file for parseCached function
+*/
+
+#include "parseCached.hpp"
+#include "findUnits.hpp"
+#include "UnitCache.hpp"
+#include "BasicXMLParser.hpp"
+#include <vector>
+
+/*
+    Parse a srcML document in memory, with the measures of the child
+    units of an archive kept in a cache by the hash of their bytes, so
+    a run on an archive where most units are unchanged parses only the
+    changed ones. The units are found by findUnits, and a unit whose
+    start tag is in the cache, with the hash and length of its bytes,
+    is added to the handler from its row, with no scan or parse. The
+    markup between the units is parsed, so the measures add up to those
+    of a parse of the whole document. The cache is then written with a
+    row for each unit of the document. A document that is not an archive
+    is parsed with no cache.
+
+    @param[in] document Complete srcML document
+    @param[in, out] handler Handler for the document, with the measures
+    @param[in] cachePath Path of the cache file
+    @param[out] saved False when the cache could not be written
+    @param[out] error First error in the document, with its position in the whole document
+    @return Number of bytes parsed, or of cached units
+*/
+std::int64_t parseCached(std::string_view document, srcFactsParser& handler, const std::string& cachePath, bool& saved, XMLParserError& error) {
+    saved = true;
+
+    // a missing cache, or one of another version, has no rows
+    UnitCache cache;
+    cache.load(cachePath);
+
+    // an unchanged unit is found by its start tag, and skipped by the scan for the units
+    std::vector<UnitCache::Row> rows;
+    std::vector<bool> cached;
+    const std::vector<std::string_view> units = findUnits(document, [&](std::string_view startTag) {
+        UnitCache::Row row;
+        row.tagHash = UnitCache::hash(startTag);
+        const UnitCache::Row* cachedRow = cache.find(row.tagHash, document.substr(std::distance(document.data(), startTag.data())));
+        rows.push_back(cachedRow ? *cachedRow : row);
+        cached.push_back(cachedRow != nullptr);
+        return cachedRow ? static_cast<std::size_t>(cachedRow->length) : 0;
+    });
+    BasicXMLParser<srcFactsParser> parser(handler, std::string_view());
+    if (units.empty()) {
+        error = parser.parse(document);
+        return parser.getTotalBytes();
+    }
+
+    // markup before each unit, from the archive start tag at depth 0, then the unit,
+    // and the markup after the last unit, with the archive end tag
+    UnitCache updated;
+    std::int64_t totalBytes = 0;
+    const char* markupStart = document.data();
+    for (std::size_t i = 0; i <= units.size(); ++i) {
+        const char* const markupEnd = i < units.size() ? units[i].data() : document.data() + document.size();
+        error = parser.parse(std::string_view(markupStart, std::distance(markupStart, markupEnd)), i == 0 ? 0 : 1);
+        totalBytes += parser.getTotalBytes();
+        if (error) {
+            error.locate(document, std::distance(document.data(), markupStart) + error.offset);
+            return totalBytes;
+        }
+        if (i == units.size())
+            break;
+
+        UnitCache::Row& row = rows[i];
+        if (cached[i]) {
+            handler.addUnit(row.counts);
+            totalBytes += row.length;
+        } else {
+            const srcFactsParser::UnitCounts before = handler.getUnitCounts();
+            error = parser.parse(units[i], 1);
+            totalBytes += parser.getTotalBytes();
+            if (error) {
+                error.locate(document, std::distance(document.data(), units[i].data()) + error.offset);
+                return totalBytes;
+            }
+            const srcFactsParser::UnitCounts after = handler.getUnitCounts();
+            for (int measure = 0; measure < srcFactsParser::UNIT_MEASURES; ++measure)
+                row.counts[measure] = after[measure] - before[measure];
+            row.hash = UnitCache::hash(units[i]);
+            row.length = static_cast<std::int64_t>(units[i].size());
+        }
+        updated.add(row);
+        markupStart = units[i].data() + units[i].size();
+    }
+
+    saved = updated.save(cachePath);
+
+    return totalBytes;
+}
@@ -0,0 +1,37 @@
+/*
+    parseCached.hpp
+
+    Include file for the parseCached function
+*/
+
+#ifndef INCLUDED_PARSECACHED_HPP
+#define INCLUDED_PARSECACHED_HPP
+
+#include <string_view>
+#include <string>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+#include "XMLParserError.hpp"
+
+/*
+    Parse a srcML document in memory, with the measures of the child
+    units of an archive kept in a cache by the hash of their bytes, so
+    a run on an archive where most units are unchanged parses only the
+    changed ones. The units are found by findUnits, and a unit whose
+    start tag is in the cache, with the hash and length of its bytes,
+    is added to the handler from its row, with no scan or parse. The
+    markup between the units is parsed, so the measures add up to those
+    of a parse of the whole document. The cache is then written with a
+    row for each unit of the document. A document that is not an archive
+    is parsed with no cache.
+
+    @param[in] document Complete srcML document
+    @param[in, out] handler Handler for the document, with the measures
+    @param[in] cachePath Path of the cache file
+    @param[out] saved False when the cache could not be written
+    @param[out] error First error in the document, with its position in the whole document
+    @return Number of bytes parsed, or of cached units
+*/
+std::int64_t parseCached(std::string_view document, srcFactsParser& handler, const std::string& cachePath, bool& saved, XMLParserError& error);
+
+#endif
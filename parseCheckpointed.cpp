@@ -0,0 +1,166 @@
+/*
+    parseCheckpointed.cpp
+
+    Implementation file for parseCheckpointed function
+*/
+
+#include "parseCheckpointed.hpp"
+#include "splitUnits.hpp"
+#include "BasicXMLParser.hpp"
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+#include <limits>
+
+// first line of a checkpoint, with the version of its format
+const std::string_view CHECKPOINT_HEADER = "srcFacts checkpoint 1";
+
+// start of the document that identifies it, with its size
+const std::size_t IDENTITY_SIZE = 64 * 1024;
+
+/*
+    Hashes the start of a document, so a checkpoint is only resumed
+    for the document it was written for
+    Input: The document
+    Output: FNV-1a hash of the start of the document
+*/
+static std::uint64_t identityHash(std::string_view document) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const char c : document.substr(0, IDENTITY_SIZE)) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/*
+    Reads a checkpoint of the document
+    Input: Path of the checkpoint, the document, and the handler
+    Output: Counts restored to the handler, offset of the next unit, and
+            number of bytes parsed before it; bool value for whether
+            there is a checkpoint of this document
+*/
+static bool readCheckpoint(const std::string& path, std::string_view document, srcFactsParser& handler,
+                           std::int64_t& offset, std::int64_t& totalBytes) {
+    std::ifstream in(path);
+    std::string header;
+    if (!std::getline(in, header) || header != CHECKPOINT_HEADER)
+        return false;
+
+    std::uint64_t size = 0;
+    std::uint64_t hash = 0;
+    int depth = 0;
+    in >> size >> hash >> offset >> depth >> totalBytes;
+    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    if (!in || size != document.size() || hash != identityHash(document) || depth != 1
+        || offset <= 0 || offset >= static_cast<std::int64_t>(document.size()))
+        return false;
+
+    return handler.restore(in);
+}
+
+/*
+    Writes a checkpoint of the document, to a temporary file renamed
+    over the checkpoint, so a run stopped while writing it leaves the
+    previous checkpoint
+    Input: Path of the checkpoint, the document, the handler, offset of
+           the next unit, and number of bytes parsed before it
+    Output: Checkpoint file; bool value for whether it was written
+*/
+static bool writeCheckpoint(const std::string& path, std::string_view document, const srcFactsParser& handler,
+                            std::int64_t offset, std::int64_t totalBytes) {
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::trunc);
+        out << CHECKPOINT_HEADER << '\n'
+            << document.size() << ' ' << identityHash(document) << ' ' << offset << ' ' << 1 << ' ' << totalBytes << '\n';
+        handler.save(out);
+        out.flush();
+        if (!out)
+            return false;
+    }
+
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+/*
+    Parse a srcML document in memory, with a checkpoint of the parse
+    written about every interval bytes, so a run stopped part way through
+    a huge archive resumes from the last checkpoint instead of the start.
+    The archive is cut into regions of whole child units by splitUnits,
+    and after each region, at depth 1 with no tag open, the counts so far
+    and the offset of the next unit are written to the checkpoint file.
+    A checkpoint of the same document, by its size and a hash of its
+    start, is resumed from, and the file is removed when the parse is
+    complete. A document that is not an archive is parsed with no
+    checkpoint.
+
+    @param[in] document Complete srcML document
+    @param[in, out] handler Handler for the document, with the counts
+    @param[in] checkpointPath Path of the checkpoint file
+    @param[in] interval Number of bytes parsed between checkpoints
+    @param[out] saved False when a checkpoint could not be written
+    @param[out] error First error in the document, with its position in the whole document
+    @return Number of bytes parsed, including the ones before a resumed checkpoint
+*/
+std::int64_t parseCheckpointed(std::string_view document, srcFactsParser& handler, const std::string& checkpointPath,
+                               std::int64_t interval, bool& saved, XMLParserError& error) {
+    saved = true;
+
+    // a cut for each interval, at the next unit start tag
+    const std::int64_t regionCount = static_cast<std::int64_t>(document.size()) / std::max<std::int64_t>(1, interval);
+    const std::vector<std::string_view> chunks = splitUnits(document,
+        static_cast<int>(std::clamp<std::int64_t>(regionCount, 1, std::numeric_limits<int>::max())));
+    if (chunks.empty()) {
+        BasicXMLParser<srcFactsParser> parser(handler, document);
+        error = parser.parse();
+        return parser.getTotalBytes();
+    }
+
+    // resumed after the last checkpoint, or from the archive start tag before the first unit
+    std::int64_t offset = 0;
+    std::int64_t totalBytes = 0;
+    if (!readCheckpoint(checkpointPath, document, handler, offset, totalBytes)) {
+        const srcFactsParser::UnitRecording unitRecording = handler.getUnitRecording();
+        handler = srcFactsParser();
+        handler.setUnitRecording(unitRecording);
+        const std::string_view prefix(document.data(), std::distance(document.data(), chunks.front().data()));
+        BasicXMLParser<srcFactsParser> prefixParser(handler, prefix);
+        error = prefixParser.parse();
+        if (error)
+            return prefixParser.getTotalBytes();
+        offset = prefix.size();
+        totalBytes = prefixParser.getTotalBytes();
+    }
+
+    // each region is parsed with its own handler, so one that does not end at
+    // depth 1 outside of markup is parsed again through the next chunk
+    const char* regionStart = document.data() + offset;
+    for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        const char* regionEnd = chunks[chunk].data() + chunks[chunk].size();
+        if (regionEnd <= regionStart)
+            continue;
+        const bool last = chunk + 1 == chunks.size();
+
+        srcFactsParser regionHandler;
+        regionHandler.setUnitRecording(handler.getUnitRecording());
+        BasicXMLParser<srcFactsParser> parser(regionHandler, std::string_view(regionStart, std::distance(regionStart, regionEnd)), 1);
+        error = parser.parse();
+        if (!last && (error || parser.getDepth() != 1 || parser.isInMarkup()))
+            continue;
+        if (error) {
+            error.locate(document, std::distance(document.data(), regionStart) + error.offset);
+            return totalBytes + parser.getTotalBytes();
+        }
+        handler.merge(regionHandler);
+        totalBytes += parser.getTotalBytes();
+        regionStart = regionEnd;
+
+        if (!last && !writeCheckpoint(checkpointPath, document, handler, std::distance(document.data(), regionStart), totalBytes))
+            saved = false;
+    }
+    std::remove(checkpointPath.c_str());
+
+    return totalBytes;
+}
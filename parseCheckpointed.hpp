@@ -0,0 +1,39 @@
+/*
+    parseCheckpointed.hpp
+
+    Include file for the parseCheckpointed function
+*/
+
+#ifndef INCLUDED_PARSECHECKPOINTED_HPP
+#define INCLUDED_PARSECHECKPOINTED_HPP
+
+#include <string_view>
+#include <string>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+#include "XMLParserError.hpp"
+
+/*
+    Parse a srcML document in memory, with a checkpoint of the parse
+    written about every interval bytes, so a run stopped part way through
+    a huge archive resumes from the last checkpoint instead of the start.
+    The archive is cut into regions of whole child units by splitUnits,
+    and after each region, at depth 1 with no tag open, the counts so far
+    and the offset of the next unit are written to the checkpoint file.
+    A checkpoint of the same document, by its size and a hash of its
+    start, is resumed from, and the file is removed when the parse is
+    complete. A document that is not an archive is parsed with no
+    checkpoint.
+
+    @param[in] document Complete srcML document
+    @param[in, out] handler Handler for the document, with the counts
+    @param[in] checkpointPath Path of the checkpoint file
+    @param[in] interval Number of bytes parsed between checkpoints
+    @param[out] saved False when a checkpoint could not be written
+    @param[out] error First error in the document, with its position in the whole document
+    @return Number of bytes parsed, including the ones before a resumed checkpoint
+*/
+std::int64_t parseCheckpointed(std::string_view document, srcFactsParser& handler, const std::string& checkpointPath,
+                               std::int64_t interval, bool& saved, XMLParserError& error);
+
+#endif
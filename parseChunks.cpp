@@ -0,0 +1,145 @@
+/*
+    parseChunks.cpp
+
+    Implementation file for parseChunks function
+*/
+
+#include "parseChunks.hpp"
+#include "splitChunks.hpp"
+#include "BasicXMLParser.hpp"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <iterator>
+
+// depth a chunk is parsed at when its real depth is not known yet. The
+// parser skips characters at depth 0, so a chunk that stays inside the
+// root element has the same counts at this depth as at its real one,
+// once merged with the difference in depth.
+const int SPECULATIVE_DEPTH = 1 << 20;
+
+namespace {
+
+    // parse of one chunk, or of several after a wrong guess
+    struct ChunkResult {
+        std::unique_ptr<srcFactsParser> handler;
+        std::int64_t bytes = 0;
+        int depth = 0;
+        int minimumDepth = 0;
+        int depthOffset = 0;
+        bool inMarkup = false;
+        XMLParserError error;
+    };
+
+    /*
+        Parse a chunk of the document starting at a depth outside of markup
+
+        @param[in] chunk Chunk of the document
+        @param[in] depth Depth at the start of the chunk
+        @param[in] unitRecording Units the handler records
+        @return Handler and end state of the parse
+    */
+    ChunkResult parseChunk(std::string_view chunk, int depth, srcFactsParser::UnitRecording unitRecording) {
+        ChunkResult result;
+        result.handler = std::make_unique<srcFactsParser>();
+        result.handler->setUnitRecording(unitRecording);
+        BasicXMLParser<srcFactsParser> parser(*result.handler, chunk, depth);
+        result.error = parser.parse();
+        result.bytes = parser.getTotalBytes();
+        result.depth = parser.getDepth();
+        result.minimumDepth = parser.getMinimumDepth();
+        result.inMarkup = parser.isInMarkup();
+
+        return result;
+    }
+}
+
+/*
+    Parse an XML document in memory speculatively in parallel, whatever
+    its structure. The document is split into chunks, and each chunk is
+    parsed by a pool of worker threads on a guess of its start state.
+    The guesses are then checked in document order against the end of
+    the previous chunk, and only a chunk with a wrong guess is parsed
+    again, on the calling thread, before its counts are merged into the
+    given handler.
+
+    @param[in] document Complete XML document
+    @param[in, out] handler Handler for the document, with the merged counts
+    @param[in] threadCount Number of worker threads
+    @param[out] error First error in the document, with its position in the whole document
+    @return Number of bytes parsed
+*/
+std::int64_t parseChunks(std::string_view document, srcFactsParser& handler, int threadCount, XMLParserError& error) {
+
+    if (threadCount <= 1) {
+        BasicXMLParser<srcFactsParser> parser(handler, document);
+        error = parser.parse();
+        return parser.getTotalBytes();
+    }
+
+    // the first chunk starts the document, and every other chunk starts
+    // on the guess of a '<' outside of markup at an unknown depth
+    const std::vector<std::string_view> chunks = splitChunks(document, threadCount * 4);
+    const srcFactsParser::UnitRecording unitRecording = handler.getUnitRecording();
+    std::vector<ChunkResult> results(chunks.size());
+    std::atomic<std::size_t> nextChunk(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::min(threadCount, static_cast<int>(chunks.size())); ++i) {
+        workers.emplace_back([&] {
+            for (std::size_t chunk = nextChunk++; chunk < chunks.size(); chunk = nextChunk++)
+                results[chunk] = parseChunk(chunks[chunk], chunk == 0 ? 0 : SPECULATIVE_DEPTH, unitRecording);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    // check each guess against the end of the parse before it, where the
+    // parse of the first chunk is from the real start of the document
+    const char* regionStart = chunks.front().data();
+    int regionDepth = 0;
+    ChunkResult region = std::move(results.front());
+    std::int64_t totalBytes = 0;
+    std::size_t extension = 1;
+    for (std::size_t chunk = 1; chunk < chunks.size(); ++chunk) {
+        ChunkResult& result = results[chunk];
+        const int depth = region.depth;
+        if (region.inMarkup || region.error) {
+            // cut was in markup, or in a construct the region cannot finish,
+            // so parse the region again through this chunk, and twice as many
+            // chunks as the last time, so a construct over many chunks is
+            // parsed again a number of times logarithmic in their number
+            chunk = std::min(chunk + extension - 1, chunks.size() - 1);
+            extension *= 2;
+            const char* const regionEnd = chunks[chunk].data() + chunks[chunk].size();
+            region = parseChunk(std::string_view(regionStart, std::distance(regionStart, regionEnd)), regionDepth, unitRecording);
+            continue;
+        }
+        extension = 1;
+
+        handler.merge(*region.handler, region.depthOffset);
+        totalBytes += region.bytes;
+        regionStart = chunks[chunk].data();
+        regionDepth = depth;
+        if (!result.error && depth + result.minimumDepth - SPECULATIVE_DEPTH > 0) {
+            // guess is right, so only the depth needs to be moved
+            region = std::move(result);
+            region.depthOffset = depth - SPECULATIVE_DEPTH;
+            region.depth += region.depthOffset;
+        } else {
+            // guess is right, but the chunk leaves the root element, or
+            // stopped at an error that may only be from the guessed depth
+            region = parseChunk(chunks[chunk], depth, unitRecording);
+        }
+    }
+    handler.merge(*region.handler, region.depthOffset);
+    totalBytes += region.bytes;
+
+    // an error in the last region is in the document, and not from a cut
+    error = region.error;
+    if (error)
+        error.locate(document, std::distance(document.data(), regionStart) + region.error.offset);
+
+    return totalBytes;
+}
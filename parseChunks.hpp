@@ -0,0 +1,32 @@
+/*
+    parseChunks.hpp
+
+    Include file for the parseChunks function
+*/
+
+#ifndef INCLUDED_PARSECHUNKS_HPP
+#define INCLUDED_PARSECHUNKS_HPP
+
+#include <string_view>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+#include "XMLParserError.hpp"
+
+/*
+    Parse an XML document in memory speculatively in parallel, whatever
+    its structure. The document is split into chunks, and each chunk is
+    parsed by a pool of worker threads on a guess of its start state.
+    The guesses are then checked in document order against the end of
+    the previous chunk, and only a chunk with a wrong guess is parsed
+    again, on the calling thread, before its counts are merged into the
+    given handler.
+
+    @param[in] document Complete XML document
+    @param[in, out] handler Handler for the document, with the merged counts
+    @param[in] threadCount Number of worker threads
+    @param[out] error First error in the document, with its position in the whole document
+    @return Number of bytes parsed
+*/
+std::int64_t parseChunks(std::string_view document, srcFactsParser& handler, int threadCount, XMLParserError& error);
+
+#endif
@@ -0,0 +1,84 @@
+/*
+    parseFiles.cpp
+
+    Implementation file for parseFiles function
+*/
+
+#include "parseFiles.hpp"
+#include "BasicXMLParser.hpp"
+#include "MappedFile.hpp"
+#include "DecompressInput.hpp"
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <utility>
+#include <fcntl.h>
+
+#if !defined(_MSC_VER)
+#include <unistd.h>
+#else
+#include <io.h>
+#define open _open
+#define close _close
+#endif
+
+// read-ahead buffer of a compressed file, smaller than for a single
+// document since every worker has its own ring
+const size_t FILE_BLOCK_SIZE = 1024 * 1024;
+
+/*
+    Parse many srcML files, with the files parsed in parallel. A pool of
+    worker threads takes the files in turn, each with its own parser and
+    handler, which are kept for all of its files. A file is memory mapped
+    and parsed in place, or decompressed on the fly when it ends in .gz,
+    .zip, or .zst.
+
+    @param[in] filenames Paths of the srcML files
+    @param[out] handlers Handler for each file, with its counts
+    @param[out] totalBytes Number of bytes parsed for each file, -1 for a file that cannot be read
+    @param[out] errors Error for each file, with its position, or none
+    @param[in] threadCount Number of worker threads
+    @param[in] unitRecording Units each handler records, e.g., for the measures of each file
+*/
+void parseFiles(const std::vector<std::string>& filenames, std::vector<srcFactsParser>& handlers,
+    std::vector<std::int64_t>& totalBytes, std::vector<XMLParserError>& errors, int threadCount,
+    srcFactsParser::UnitRecording unitRecording) {
+
+    srcFactsParser recordingHandler;
+    recordingHandler.setUnitRecording(unitRecording);
+    handlers.assign(filenames.size(), recordingHandler);
+    totalBytes.assign(filenames.size(), -1);
+    errors.assign(filenames.size(), XMLParserError());
+
+    // files are taken in order by whichever worker is free
+    std::atomic<std::size_t> nextFile(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::min(threadCount, static_cast<int>(filenames.size())); ++i) {
+        workers.emplace_back([&] {
+            // the counts of each file are swapped out for the new handler of the next
+            srcFactsParser handler = recordingHandler;
+            BasicXMLParser<srcFactsParser> parser(handler, std::string_view());
+            for (std::size_t file = nextFile++; file < filenames.size(); file = nextFile++) {
+                if (DecompressInput::isCompressed(filenames[file])) {
+                    const int fd = open(filenames[file].c_str(), O_RDONLY);
+                    if (fd == -1)
+                        continue;
+                    {
+                        DecompressInput input(fd, FILE_BLOCK_SIZE);
+                        errors[file] = parser.parse(input);
+                    }
+                    close(fd);
+                } else {
+                    const MappedFile mappedFile(filenames[file]);
+                    if (!mappedFile.isValid())
+                        continue;
+                    errors[file] = parser.parse(mappedFile.view());
+                }
+                totalBytes[file] = parser.getTotalBytes();
+                std::swap(handler, handlers[file]);
+            }
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
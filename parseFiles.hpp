@@ -0,0 +1,33 @@
+/*
+    parseFiles.hpp
+
+    Include file for the parseFiles function
+*/
+
+#ifndef INCLUDED_PARSEFILES_HPP
+#define INCLUDED_PARSEFILES_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+#include "XMLParserError.hpp"
+
+/*
+    Parse many srcML files, with the files parsed in parallel. A pool of
+    worker threads takes the files in turn, each with its own parser and
+    handler. A file is memory mapped and parsed in place, or decompressed
+    on the fly when it ends in .gz, .zip, or .zst.
+
+    @param[in] filenames Paths of the srcML files
+    @param[out] handlers Handler for each file, with its counts
+    @param[out] totalBytes Number of bytes parsed for each file, -1 for a file that cannot be read
+    @param[out] errors Error for each file, with its position, or none
+    @param[in] threadCount Number of worker threads
+    @param[in] unitRecording Units each handler records, e.g., for the measures of each file
+*/
+void parseFiles(const std::vector<std::string>& filenames, std::vector<srcFactsParser>& handlers,
+    std::vector<std::int64_t>& totalBytes, std::vector<XMLParserError>& errors, int threadCount,
+    srcFactsParser::UnitRecording unitRecording);
+
+#endif
@@ -0,0 +1,51 @@
+/*
+    parseIndexedUnits.cpp
+
+    Implementation file for parseIndexedUnits function
+*/
+
+#include "parseIndexedUnits.hpp"
+#include "BasicXMLParser.hpp"
+#include <cctype>
+
+/*
+    Parse only the child units of a srcML archive in memory whose
+    filename starts with a prefix, e.g., "drivers/net/", found with an
+    index of the archive instead of a parse of the whole document. The
+    archive start tag is parsed first, and then each selected unit at
+    depth 1, so the rest of the document, e.g., a MappedFile, is never
+    read.
+
+    @param[in] document Complete srcML document
+    @param[in] index Index of the document
+    @param[in] filenamePrefix Start of the filename of the selected units
+    @param[in, out] handler Handler for the selected units
+    @param[out] error First error in the selected units, with its position in the whole document
+    @return Number of bytes parsed
+*/
+std::int64_t parseIndexedUnits(std::string_view document, const UnitIndex& index, std::string_view filenamePrefix,
+                               srcFactsParser& handler, XMLParserError& error) {
+    const auto& entries = index.getEntries();
+
+    // archive start tag, with its attributes, before the first unit, without
+    // the space after it, which is in none of the units
+    std::size_t prefixSize = entries.empty() ? document.size() : static_cast<std::size_t>(entries.front().offset);
+    while (!entries.empty() && prefixSize > 0 && isspace(static_cast<unsigned char>(document[prefixSize - 1])))
+        --prefixSize;
+    BasicXMLParser<srcFactsParser> parser(handler, document.substr(0, prefixSize));
+    error = parser.parse();
+    std::int64_t totalBytes = parser.getTotalBytes();
+
+    for (const auto& entry : entries) {
+        if (error)
+            break;
+        if (entry.filename.compare(0, filenamePrefix.size(), filenamePrefix) != 0)
+            continue;
+        error = parser.parse(document.substr(entry.offset, entry.length), 1);
+        totalBytes += parser.getTotalBytes();
+        if (error)
+            error.locate(document, entry.offset + error.offset);
+    }
+
+    return totalBytes;
+}
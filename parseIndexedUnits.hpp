@@ -0,0 +1,34 @@
+/*
+    parseIndexedUnits.hpp
+
+    Include file for the parseIndexedUnits function
+*/
+
+#ifndef INCLUDED_PARSEINDEXEDUNITS_HPP
+#define INCLUDED_PARSEINDEXEDUNITS_HPP
+
+#include <string_view>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+#include "UnitIndex.hpp"
+#include "XMLParserError.hpp"
+
+/*
+    Parse only the child units of a srcML archive in memory whose
+    filename starts with a prefix, e.g., "drivers/net/", found with an
+    index of the archive instead of a parse of the whole document. The
+    archive start tag is parsed first, and then each selected unit at
+    depth 1, so the rest of the document, e.g., a MappedFile, is never
+    read.
+
+    @param[in] document Complete srcML document
+    @param[in] index Index of the document
+    @param[in] filenamePrefix Start of the filename of the selected units
+    @param[in, out] handler Handler for the selected units
+    @param[out] error First error in the selected units, with its position in the whole document
+    @return Number of bytes parsed
+*/
+std::int64_t parseIndexedUnits(std::string_view document, const UnitIndex& index, std::string_view filenamePrefix,
+                               srcFactsParser& handler, XMLParserError& error);
+
+#endif
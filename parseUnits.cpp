@@ -0,0 +1,79 @@
+/*
+    parseUnits.cpp
+
+    Implementation file for parseUnits function
+*/
+
+#include "parseUnits.hpp"
+#include "splitUnits.hpp"
+#include "parseChunks.hpp"
+#include "BasicXMLParser.hpp"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+/*
+    Parse a srcML document in memory, with the child units of an
+    archive parsed in parallel. The units are split into chunks that
+    a pool of worker threads takes in turn, each with its own parser
+    and handler, and the counts of the chunks are merged into the given
+    handler in document order. A document that is not an archive, or
+    whose split is not at child units, is parsed with parseChunks.
+
+    @param[in] document Complete srcML document
+    @param[in, out] handler Handler for the document, with the merged counts
+    @param[in] threadCount Number of worker threads
+    @param[out] error First error in the document, with its position in the whole document
+    @return Number of bytes parsed
+*/
+std::int64_t parseUnits(std::string_view document, srcFactsParser& handler, int threadCount, XMLParserError& error) {
+
+    // a few chunks per thread balance the load when units vary in size
+    const std::vector<std::string_view> chunks = threadCount > 1 ? splitUnits(document, threadCount * 4) : std::vector<std::string_view>();
+    const srcFactsParser::UnitRecording unitRecording = handler.getUnitRecording();
+
+    // chunks are taken in document order by whichever worker is free
+    std::vector<std::unique_ptr<srcFactsParser>> results(chunks.size());
+    std::vector<std::int64_t> resultBytes(chunks.size(), 0);
+    std::atomic<bool> valid(!chunks.empty());
+    std::atomic<std::size_t> nextChunk(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::min(threadCount, static_cast<int>(chunks.size())); ++i) {
+        workers.emplace_back([&] {
+            for (std::size_t chunk = nextChunk++; chunk < chunks.size() && valid; chunk = nextChunk++) {
+                results[chunk] = std::make_unique<srcFactsParser>();
+                results[chunk]->setUnitRecording(unitRecording);
+                BasicXMLParser<srcFactsParser> parser(*results[chunk], chunks[chunk], 1);
+                const bool failed = static_cast<bool>(parser.parse());
+                resultBytes[chunk] = parser.getTotalBytes();
+
+                // the next chunk starts at a child unit only if this one ends at depth 1,
+                // and an error is located by parseChunks in the whole document
+                if (failed || (chunk + 1 < chunks.size() && (parser.getDepth() != 1 || parser.isInMarkup())))
+                    valid = false;
+            }
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    if (!valid)
+        return parseChunks(document, handler, threadCount, error);
+
+    // archive start tag, with its attributes, before the first unit
+    const std::string_view prefix(document.data(), std::distance(document.data(), chunks.front().data()));
+    BasicXMLParser<srcFactsParser> prefixParser(handler, prefix);
+    error = prefixParser.parse();
+    if (error)
+        return prefixParser.getTotalBytes();
+    std::int64_t totalBytes = prefixParser.getTotalBytes();
+
+    for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        handler.merge(*results[chunk]);
+        totalBytes += resultBytes[chunk];
+    }
+
+    return totalBytes;
+}
@@ -0,0 +1,31 @@
+/*
+    parseUnits.hpp
+
+    Include file for the parseUnits function
+*/
+
+#ifndef INCLUDED_PARSEUNITS_HPP
+#define INCLUDED_PARSEUNITS_HPP
+
+#include <string_view>
+#include <cstdint>
+#include "srcFactsParser.hpp"
+#include "XMLParserError.hpp"
+
+/*
+    Parse a srcML document in memory, with the child units of an
+    archive parsed in parallel. The units are split into chunks that
+    a pool of worker threads takes in turn, each with its own parser
+    and handler, and the counts of the chunks are merged into the given
+    handler in document order. A document that is not an archive, or
+    whose split is not at child units, is parsed with parseChunks.
+
+    @param[in] document Complete srcML document
+    @param[in, out] handler Handler for the document, with the merged counts
+    @param[in] threadCount Number of worker threads
+    @param[out] error First error in the document, with its position in the whole document
+    @return Number of bytes parsed
+*/
+std::int64_t parseUnits(std::string_view document, srcFactsParser& handler, int threadCount, XMLParserError& error);
+
+#endif
@@ -0,0 +1,163 @@
+/*
+    parseunitstest.cpp
+
+    Test of the parallel parse of a srcML archive in memory against the
+    parse of the same archive on one thread, for the measures of the
+    report, and of each unit and language. One archive has a comment with
+    a unit start tag between its units, so its split falls back to the
+    speculative parse of chunks. Others have a comment or CDATA over
+    most of the chunks, so a region of the speculative parse is extended
+    through many chunks. One archive has a prefix for the src namespace,
+    with the same measures as the archive without one.
+
+    Output is a line for each failed check, and the exit status is the
+    number of failed checks.
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include "parseUnits.hpp"
+#include "UnitTable.hpp"
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+namespace {
+
+    /*
+        An archive of units that each have 400 characters and 200 LOC,
+        with space between the units
+
+        @param[in] unitCount Number of units
+        @param[in] between Markup after the first half of the units
+        @param[in] prefix Prefix of the src namespace, with its ':', or none
+        @return The archive
+    */
+    std::string archive(int unitCount, std::string_view between, std::string_view prefix = ""sv) {
+        const std::string unitName = std::string(prefix) + "unit";
+        const std::string exprName = std::string(prefix) + "expr";
+        const std::string xmlns = prefix.empty() ? "xmlns" : "xmlns:" + std::string(prefix.substr(0, prefix.size() - 1));
+        std::string document = "<?xml version=\"1.0\"?>\n<" + unitName + " " + xmlns + "=\"http://www.srcML.org/srcML/src\">\n\n";
+        std::string text;
+        for (int line = 0; line < 200; ++line)
+            text += "a\n";
+        for (int unit = 0; unit < unitCount; ++unit) {
+            if (unit == unitCount / 2)
+                document.append(between).append("\n\n");
+            document += "<" + unitName + " filename=\"f" + std::to_string(unit) + ".cpp\" language=\"" + (unit % 2 ? "C" : "C++")
+                + "\"><" + exprName + ">" + text + "</" + exprName + "></" + unitName + ">\n\n";
+        }
+        document += "</" + unitName + ">\n";
+
+        return document;
+    }
+
+    /*
+        Parse a document with its units, and add them to a table
+
+        @param[in] document The document
+        @param[in] threadCount Number of worker threads
+        @param[out] table Measures of each unit
+        @return Measures of the report
+    */
+    srcFactsParser::UnitCounts parse(std::string_view document, int threadCount, UnitTable& table) {
+        srcFactsParser handler;
+        handler.setUnitRecording(srcFactsParser::RECORD_UNITS);
+        XMLParserError error;
+        parseUnits(document, handler, threadCount, error);
+        if (error)
+            std::cout << "parse with " << threadCount << " threads: " << error.message() << '\n';
+        table.add(handler);
+
+        return handler.getUnitCounts();
+    }
+
+    /*
+        Parse a document on several threads, and check the measures against
+        the parse on one thread
+
+        @param[in] name Name of the check
+        @param[in] document The document
+        @return Number of failed checks
+    */
+    int check(std::string_view name, const std::string& document) {
+        int failed = 0;
+        UnitTable expectedTable;
+        const srcFactsParser::UnitCounts expected = parse(document, 1, expectedTable);
+        // each unit has its own 400 characters and 200 LOC, without the space between them
+        for (std::size_t unit = 0; unit < expectedTable.size(); ++unit) {
+            if (expectedTable.counts[srcFactsParser::TEXTSIZE][unit] != 400 || expectedTable.counts[srcFactsParser::LOC][unit] != 200) {
+                std::cout << name << ": " << expectedTable.filenames[unit] << " has " << expectedTable.counts[srcFactsParser::TEXTSIZE][unit]
+                          << " characters and " << expectedTable.counts[srcFactsParser::LOC][unit] << " LOC\n";
+                ++failed;
+            }
+        }
+
+        for (int threadCount = 2; threadCount <= 8; ++threadCount) {
+            UnitTable table;
+            if (parse(document, threadCount, table) != expected) {
+                std::cout << name << " with " << threadCount << " threads: measures of the report differ\n";
+                ++failed;
+            }
+            if (table.filenames != expectedTable.filenames || table.languages != expectedTable.languages || table.counts != expectedTable.counts) {
+                std::cout << name << " with " << threadCount << " threads: measures of the units differ\n";
+                ++failed;
+            }
+            if (table.languageTotals() != expectedTable.languageTotals()) {
+                std::cout << name << " with " << threadCount << " threads: measures of the languages differ\n";
+                ++failed;
+            }
+        }
+
+        return failed;
+    }
+
+    /*
+        Parse a document with a prefix for the src namespace, and check the
+        measures against the parse of the same document without one
+
+        @param[in] name Name of the check
+        @param[in] document The document with the prefix
+        @param[in] plainDocument The document without the prefix
+        @return Number of failed checks
+    */
+    int checkPrefixed(std::string_view name, const std::string& document, const std::string& plainDocument) {
+        int failed = 0;
+        UnitTable expectedTable;
+        const srcFactsParser::UnitCounts expected = parse(plainDocument, 1, expectedTable);
+        UnitTable table;
+        if (parse(document, 1, table) != expected) {
+            std::cout << name << ": measures of the report differ\n";
+            ++failed;
+        }
+        if (table.filenames != expectedTable.filenames || table.counts != expectedTable.counts) {
+            std::cout << name << ": measures of the units differ\n";
+            ++failed;
+        }
+
+        return failed + check(name, document);
+    }
+}
+
+int main() {
+    int failed = 0;
+
+    // split at the child units
+    failed += check("archive"sv, archive(8, "<!-- comment -->"sv));
+
+    // split at a unit start tag in a comment, so parsed by speculative chunks
+    failed += check("unit in comment"sv, archive(8, "<!-- <unit x=\"1\"> -->"sv));
+
+    // markup over most of the chunks of the speculative parse
+    std::string longText;
+    for (int i = 0; i < 300000; ++i)
+        longText += "<unit> x ";
+    failed += check("long comment"sv, archive(8, "<!-- " + longText + " -->"));
+    failed += check("long CDATA"sv, archive(8, "<![CDATA[" + longText + "]]>"));
+
+    // names of the src namespace with a prefix
+    failed += checkPrefixed("prefixed"sv, archive(8, "<!-- comment -->"sv, "src:"sv), archive(8, "<!-- comment -->"sv));
+
+    return failed;
+}
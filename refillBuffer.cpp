@@ -30,32 +30,47 @@ typedef SSIZE_T ssize_t;
     @retval 0 EOF
     @retval -1 Read error
 */
-int refillBuffer(std::string::const_iterator& cursor, std::string::const_iterator& cursorEnd, std::string& buffer) {
+int refillBuffer(const char*& cursor, const char*& cursorEnd, std::string& buffer) {
+
+    return refillBuffer(cursor, cursorEnd, buffer.data(), buffer.size());
+}
+
+/*
+    Refill a caller-owned buffer preserving the unused data.
+    Current content [cursor, cursorEnd) is shifted left and new data
+    appended to the rest of the buffer.
+
+    @param[in,out] cursor Iterator to current position in buffer
+    @param[in, out] cursorEnd Iterator to end of buffer for this read
+    @param[in, out] buffer Start of the characters
+    @param[in] size Size of the buffer
+    @return Number of bytes read
+    @retval 0 EOF
+    @retval -1 Read error
+*/
+int refillBuffer(const char*& cursor, const char*& cursorEnd, char* buffer, std::size_t size) {
 
     // number of unprocessed characters [cursor, cursorEnd)
     size_t unprocessed = std::distance(cursor, cursorEnd);
 
     // move unprocessed characters, [cursor, cursorEnd), to start of the buffer
-    std::copy(cursor, cursorEnd, buffer.begin());
+    std::copy(cursor, cursorEnd, buffer);
 
     // reset cursors
-    cursor = buffer.begin();
+    cursor = buffer;
     cursorEnd = cursor + unprocessed;
 
     // read in whole blocks
     ssize_t readBytes = 0;
-    while (((readBytes = READ(0, static_cast<void*>(buffer.data() + unprocessed),
-        std::distance(cursorEnd, buffer.cend()))) == -1) && (errno == EINTR)) {
+    while (((readBytes = READ(0, static_cast<void*>(buffer + unprocessed),
+        size - unprocessed)) == -1) && (errno == EINTR)) {
     }
     if (readBytes == -1)
         // error in read
         return -1;
-    if (readBytes == 0) {
-        // EOF
-        cursor = buffer.cend();
-        cursorEnd = buffer.cend();
+    if (readBytes == 0)
+        // EOF, with the unprocessed characters still at the start of the buffer
         return 0;
-    }
 
     // adjust the end of the cursor to the new bytes
     cursorEnd += readBytes;
@@ -21,6 +21,21 @@
     @retval 0 EOF
     @retval -1 Read error
 */
-int refillBuffer(std::string::const_iterator& cursor, std::string::const_iterator& cursorEnd, std::string& buffer);
+int refillBuffer(const char*& cursor, const char*& cursorEnd, std::string& buffer);
+
+/*
+    Refill a caller-owned buffer preserving the unused data.
+    Current content [cursor, cursorEnd) is shifted left and new data
+    appended to the rest of the buffer.
+
+    @param[in,out] cursor Iterator to current position in buffer
+    @param[in, out] cursorEnd Iterator to end of buffer for this read
+    @param[in, out] buffer Start of the characters
+    @param[in] size Size of the buffer
+    @return Number of bytes read
+    @retval 0 EOF
+    @retval -1 Read error
+*/
+int refillBuffer(const char*& cursor, const char*& cursorEnd, char* buffer, std::size_t size);
 
 #endif
@@ -0,0 +1,131 @@
+/*
+    scanCharacters.cpp
+
+    Implementation file for scanCharacters function
+*/
+
+#include "scanCharacters.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SCAN_CHARACTERS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    /*
+        Scan one byte at a time, for the end of the buffer and for
+        processors without SIMD
+
+        @param[in] cursor Start of the characters
+        @param[in] cursorEnd End of the characters in the buffer
+        @param[in, out] newlineCount Number of newlines, added to
+        @return Position of the next '<' or '&'
+    */
+    const char* scanScalar(const char* cursor, const char* cursorEnd, int& newlineCount) {
+        for (; cursor != cursorEnd; ++cursor) {
+            if (*cursor == '<' || *cursor == '&')
+                break;
+            if (*cursor == '\n')
+                ++newlineCount;
+        }
+
+        return cursor;
+    }
+
+#ifdef SCAN_CHARACTERS_X86
+    /*
+        Scan 16 bytes at a time with SSE2
+
+        @param[in] cursor Start of the characters
+        @param[in] cursorEnd End of the characters in the buffer
+        @param[in, out] newlineCount Number of newlines, added to
+        @return Position of the next '<' or '&'
+    */
+    __attribute__((target("sse2")))
+    const char* scanSSE2(const char* cursor, const char* cursorEnd, int& newlineCount) {
+        const __m128i lessThan = _mm_set1_epi8('<');
+        const __m128i ampersand = _mm_set1_epi8('&');
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (; cursorEnd - cursor >= 16; cursor += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+            const unsigned int stops = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, lessThan), _mm_cmpeq_epi8(block, ampersand)));
+            const unsigned int newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+            if (stops) {
+                const int offset = __builtin_ctz(stops);
+                newlineCount += __builtin_popcount(newlines & ((1u << offset) - 1));
+                return cursor + offset;
+            }
+            newlineCount += __builtin_popcount(newlines);
+        }
+
+        return scanScalar(cursor, cursorEnd, newlineCount);
+    }
+
+    /*
+        Scan 32 bytes at a time with AVX2
+
+        @param[in] cursor Start of the characters
+        @param[in] cursorEnd End of the characters in the buffer
+        @param[in, out] newlineCount Number of newlines, added to
+        @return Position of the next '<' or '&'
+    */
+    __attribute__((target("avx2,popcnt")))
+    const char* scanAVX2(const char* cursor, const char* cursorEnd, int& newlineCount) {
+        const __m256i lessThan = _mm256_set1_epi8('<');
+        const __m256i ampersand = _mm256_set1_epi8('&');
+        const __m256i newline = _mm256_set1_epi8('\n');
+        for (; cursorEnd - cursor >= 32; cursor += 32) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor));
+            const unsigned int stops = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, lessThan), _mm256_cmpeq_epi8(block, ampersand)));
+            const unsigned int newlines = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline));
+            if (stops) {
+                const int offset = __builtin_ctz(stops);
+                newlineCount += __builtin_popcount(newlines & ((1ull << offset) - 1));
+                return cursor + offset;
+            }
+            newlineCount += __builtin_popcount(newlines);
+        }
+
+        return scanSSE2(cursor, cursorEnd, newlineCount);
+    }
+#endif
+
+    using ScanFunction = const char* (*)(const char*, const char*, int&);
+
+    /*
+        Select the widest scan the processor supports
+
+        @return Scan function
+    */
+    ScanFunction selectScan() {
+#ifdef SCAN_CHARACTERS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+            return scanAVX2;
+        if (__builtin_cpu_supports("sse2"))
+            return scanSSE2;
+#endif
+        return scanScalar;
+    }
+
+    // selected once at startup
+    const ScanFunction scan = selectScan();
+}
+
+/*
+    Find the end of character content, i.e., the next '<' or '&',
+    and count the newlines before it in the same pass. Uses AVX2 or
+    SSE2 when the processor has it, and a scalar loop otherwise.
+
+    @param[in] cursor Start of the characters
+    @param[in] cursorEnd End of the characters in the buffer
+    @param[out] newlineCount Number of newlines in the characters
+    @return Position of the next '<' or '&'
+    @retval cursorEnd No '<' or '&' in the buffer
+*/
+const char* scanCharacters(const char* cursor, const char* cursorEnd, int& newlineCount) {
+    newlineCount = 0;
+
+    return scan(cursor, cursorEnd, newlineCount);
+}
@@ -0,0 +1,23 @@
+/*
+    scanCharacters.hpp
+
+    Include file for the scanCharacters function
+*/
+
+#ifndef INCLUDED_SCANCHARACTERS_HPP
+#define INCLUDED_SCANCHARACTERS_HPP
+
+/*
+    Find the end of character content, i.e., the next '<' or '&',
+    and count the newlines before it in the same pass. Uses AVX2 or
+    SSE2 when the processor has it, and a scalar loop otherwise.
+
+    @param[in] cursor Start of the characters
+    @param[in] cursorEnd End of the characters in the buffer
+    @param[out] newlineCount Number of newlines in the characters
+    @return Position of the next '<' or '&'
+    @retval cursorEnd No '<' or '&' in the buffer
+*/
+const char* scanCharacters(const char* cursor, const char* cursorEnd, int& newlineCount);
+
+#endif
@@ -0,0 +1,127 @@
+/*
+    scanName.cpp
+
+    Implementation file for scanName function
+*/
+
+#include "scanName.hpp"
+#include <array>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SCAN_NAME_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    /*
+        Build the table of name characters, indexed by the unsigned byte
+
+        @return Table with true for each name character
+    */
+    constexpr std::array<bool, 256> makeNameTable() {
+        std::array<bool, 256> table{};
+        for (int c = '0'; c <= '9'; ++c)
+            table[c] = true;
+        for (int c = 'A'; c <= 'Z'; ++c)
+            table[c] = true;
+        for (int c = 'a'; c <= 'z'; ++c)
+            table[c] = true;
+        table['-'] = true;
+        table['.'] = true;
+        table['_'] = true;
+        for (int c = 0x80; c <= 0xFF; ++c)
+            table[c] = true;
+
+        return table;
+    }
+
+    constexpr std::array<bool, 256> nameTable = makeNameTable();
+
+    /*
+        Scan one byte at a time with the table, for the end of the
+        buffer and for processors without SSSE3
+
+        @param[in] cursor Start of the name
+        @param[in] cursorEnd End of the buffer
+        @return Position of the first character after the name
+    */
+    const char* scanScalar(const char* cursor, const char* cursorEnd) {
+        while (cursor != cursorEnd && nameTable[static_cast<unsigned char>(*cursor)])
+            ++cursor;
+
+        return cursor;
+    }
+
+#ifdef SCAN_NAME_X86
+    /*
+        Scan 16 bytes at a time, where a byte is a name character when
+        the entries for its high and low nibbles share a bit:
+        * 0x01 '-' and '.'
+        * 0x02 '0' to '9'
+        * 0x04 'A' to 'O' and 'a' to 'o'
+        * 0x08 'P' to 'Z' and 'p' to 'z'
+        * 0x10 '_'
+        * 0x20 UTF-8 bytes 0x80 to 0xFF
+
+        @param[in] cursor Start of the name
+        @param[in] cursorEnd End of the buffer
+        @return Position of the first character after the name
+    */
+    __attribute__((target("ssse3")))
+    const char* scanSSSE3(const char* cursor, const char* cursorEnd) {
+        const __m128i highTable = _mm_setr_epi8(0, 0, 0x01, 0x02, 0x04, 0x08 | 0x10, 0x04, 0x08,
+                                                0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20);
+        const __m128i lowTable = _mm_setr_epi8(0x02 | 0x08 | 0x20, 0x02 | 0x04 | 0x08 | 0x20, 0x02 | 0x04 | 0x08 | 0x20, 0x02 | 0x04 | 0x08 | 0x20,
+                                               0x02 | 0x04 | 0x08 | 0x20, 0x02 | 0x04 | 0x08 | 0x20, 0x02 | 0x04 | 0x08 | 0x20, 0x02 | 0x04 | 0x08 | 0x20,
+                                               0x02 | 0x04 | 0x08 | 0x20, 0x02 | 0x04 | 0x08 | 0x20, 0x04 | 0x08 | 0x20, 0x04 | 0x20,
+                                               0x04 | 0x20, 0x01 | 0x04 | 0x20, 0x01 | 0x04 | 0x20, 0x04 | 0x10 | 0x20);
+        const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+        for (; cursorEnd - cursor >= 16; cursor += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+            const __m128i high = _mm_shuffle_epi8(highTable, _mm_and_si128(_mm_srli_epi16(block, 4), nibbleMask));
+            const __m128i low = _mm_shuffle_epi8(lowTable, _mm_and_si128(block, nibbleMask));
+            const __m128i other = _mm_cmpeq_epi8(_mm_and_si128(high, low), _mm_setzero_si128());
+            const unsigned int ends = _mm_movemask_epi8(other);
+            if (ends)
+                return cursor + __builtin_ctz(ends);
+        }
+
+        return scanScalar(cursor, cursorEnd);
+    }
+#endif
+
+    using ScanFunction = const char* (*)(const char*, const char*);
+
+    /*
+        Select the scan the processor supports
+
+        @return Scan function
+    */
+    ScanFunction selectScan() {
+#ifdef SCAN_NAME_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("ssse3"))
+            return scanSSSE3;
+#endif
+        return scanScalar;
+    }
+
+    // selected once at startup
+    const ScanFunction scan = selectScan();
+}
+
+/*
+    Find the end of an XML name, or of a part of a qualified name,
+    i.e., the first character that is not a letter, digit, '-', '.',
+    '_', or a byte of a UTF-8 character. Classifies 16 bytes at a time
+    with SSSE3 when the processor has it, and uses a table otherwise.
+
+    @param[in] cursor Start of the name
+    @param[in] cursorEnd End of the buffer
+    @return Position of the first character after the name
+    @retval cursorEnd Name continues to the end of the buffer
+*/
+const char* scanName(const char* cursor, const char* cursorEnd) {
+    return scan(cursor, cursorEnd);
+}
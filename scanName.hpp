@@ -0,0 +1,23 @@
+/*
+    scanName.hpp
+
+    Include file for the scanName function
+*/
+
+#ifndef INCLUDED_SCANNAME_HPP
+#define INCLUDED_SCANNAME_HPP
+
+/*
+    Find the end of an XML name, or of a part of a qualified name,
+    i.e., the first character that is not a letter, digit, '-', '.',
+    '_', or a byte of a UTF-8 character. Classifies 16 bytes at a time
+    with SSSE3 when the processor has it, and uses a table otherwise.
+
+    @param[in] cursor Start of the name
+    @param[in] cursorEnd End of the buffer
+    @return Position of the first character after the name
+    @retval cursorEnd Name continues to the end of the buffer
+*/
+const char* scanName(const char* cursor, const char* cursorEnd);
+
+#endif
@@ -0,0 +1,267 @@
+/*
+    skipMarkup.cpp
+
+    Implementation file for skipMarkup function
+*/
+
+#include "skipMarkup.hpp"
+#include <string_view>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+    /*
+        Count the bits of a 16-bit mask, with no library call for a
+        processor without a popcount instruction
+
+        @param[in] mask Mask of a block
+        @return Number of bits set in the mask
+    */
+    inline int countBits(unsigned int mask) {
+        mask = mask - ((mask >> 1) & 0x5555U);
+        mask = (mask & 0x3333U) + ((mask >> 2) & 0x3333U);
+        mask = (mask + (mask >> 4)) & 0x0F0FU;
+        return static_cast<int>((mask + (mask >> 8)) & 0x1FU);
+    }
+
+    /*
+        Find the next markup character, '<', '>', '"', or '\'', 16 bytes
+        at a time with SSE2, and one byte at a time otherwise
+
+        @param[in] cursor Start of the search
+        @param[in] cursorEnd End of the buffer
+        @return Position of the markup character
+        @retval cursorEnd No markup character in the buffer
+    */
+    inline const char* findMarkup(const char* cursor, const char* cursorEnd) {
+#if defined(__SSE2__)
+        const __m128i lessThan = _mm_set1_epi8('<');
+        const __m128i greaterThan = _mm_set1_epi8('>');
+        const __m128i doubleQuote = _mm_set1_epi8('"');
+        const __m128i singleQuote = _mm_set1_epi8('\'');
+        for (; cursorEnd - cursor >= 16; cursor += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+            const __m128i tags = _mm_or_si128(_mm_cmpeq_epi8(block, lessThan), _mm_cmpeq_epi8(block, greaterThan));
+            const __m128i quotes = _mm_or_si128(_mm_cmpeq_epi8(block, doubleQuote), _mm_cmpeq_epi8(block, singleQuote));
+            const unsigned int markup = _mm_movemask_epi8(_mm_or_si128(tags, quotes));
+            if (markup)
+                return cursor + __builtin_ctz(markup);
+        }
+#endif
+        for (; cursor != cursorEnd; ++cursor) {
+            if (*cursor == '<' || *cursor == '>' || *cursor == '"' || *cursor == '\'')
+                break;
+        }
+
+        return cursor;
+    }
+
+    /*
+        Skip whole tags in the content of an element 16 bytes at a time
+        with SSE2, by counting the start tags '<', and the end tags '</'
+        and empty element tags '/>' that close an element. A block stops
+        at a quote, comment, CDATA, processing instruction, or '>' in the
+        characters, and before the element can end, for skipMarkup to
+        look at one markup character at a time.
+
+        @param[in] cursor Start of the content
+        @param[in] cursorEnd End of the buffer
+        @param[in, out] level Number of open elements, greater than 0
+        @return Position after the skipped tags, in the content
+    */
+    inline const char* skipTags(const char* cursor, const char* cursorEnd, int& level) {
+#if defined(__SSE2__)
+        const __m128i lessThan = _mm_set1_epi8('<');
+        const __m128i greaterThan = _mm_set1_epi8('>');
+        const __m128i slash = _mm_set1_epi8('/');
+        const __m128i doubleQuote = _mm_set1_epi8('"');
+        const __m128i singleQuote = _mm_set1_epi8('\'');
+        const __m128i exclamation = _mm_set1_epi8('!');
+        const __m128i question = _mm_set1_epi8('?');
+
+        // a block and the byte after it, for the byte after each '<'
+        while (cursorEnd - cursor > 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+            const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor + 1));
+            const unsigned int starts = _mm_movemask_epi8(_mm_cmpeq_epi8(block, lessThan));
+            const unsigned int ends = _mm_movemask_epi8(_mm_cmpeq_epi8(block, greaterThan));
+            const unsigned int slashes = _mm_movemask_epi8(_mm_cmpeq_epi8(block, slash));
+            const unsigned int nextSlashes = _mm_movemask_epi8(_mm_cmpeq_epi8(next, slash));
+            const unsigned int quotes = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, doubleQuote), _mm_cmpeq_epi8(block, singleQuote)));
+            const unsigned int declarations = starts & _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(next, exclamation), _mm_cmpeq_epi8(next, question)));
+
+            // only the bytes before a quote, comment, CDATA, or processing instruction
+            const unsigned int stops = quotes | declarations;
+            const unsigned int window = stops ? (1U << __builtin_ctz(stops)) - 1 : 0xFFFFU;
+            const unsigned int markup = (starts | ends) & window;
+            if (!markup) {
+                if (stops)
+                    return cursor + __builtin_ctz(stops);
+                cursor += 16;
+                continue;
+            }
+
+            // outside of tags, the markup alternates between a '<' and its '>',
+            // i.e., every other markup character, by the parity of a prefix xor
+            unsigned int parity = markup;
+            parity ^= parity << 1;
+            parity ^= parity << 2;
+            parity ^= parity << 4;
+            parity ^= parity << 8;
+            if ((starts & markup) != (markup & parity))
+                return cursor + __builtin_ctz(markup);
+
+            // only the complete tags, up to the last '>'
+            const unsigned int tagEnds = ends & markup;
+            if (!tagEnds)
+                return cursor + __builtin_ctz(markup);
+            const int length = 32 - __builtin_clz(tagEnds);
+            const unsigned int tags = (1U << length) - 1;
+            const unsigned int startTags = starts & ~nextSlashes & tags;
+            const unsigned int closeTags = (starts & nextSlashes & tags) | (tagEnds & (slashes << 1));
+            const int closed = countBits(closeTags);
+
+            // the element may end in these tags
+            if (level - closed <= 0)
+                return cursor + __builtin_ctz(markup);
+
+            level += countBits(startTags) - closed;
+            cursor += length;
+        }
+#else
+        (void) cursorEnd;
+        (void) level;
+#endif
+        return cursor;
+    }
+}
+
+/*
+    Skip the rest of an element, from its start tag or its content, to
+    just past its end tag. The nesting is counted from the '<', '</', and
+    '/>' of the tags, 16 bytes at a time with SSE2 when the processor has
+    it, and otherwise from the markup characters '<', '>', '"', and '\''
+    one at a time. Comments, CDATA, and processing instructions are
+    skipped whole, and no names are parsed.
+
+    @param[in] cursor Start of the rest of the element
+    @param[in] cursorEnd End of the buffer
+    @param[in, out] state Where the skip is, with level 0 at the end of the element
+    @return Position after the element, or where the skip continues after a refill
+            that keeps [position, cursorEnd), e.g., at a '<' at the end of the buffer
+*/
+const char* skipMarkup(const char* cursor, const char* cursorEnd, SkipState& state) {
+    using namespace std::literals::string_view_literals;
+
+    const char* start = cursor;
+    while (true) {
+        if (state.mode >= SkipState::COMMENT) {
+            if (state.mode == SkipState::INVALID)
+                return cursor;
+
+            // whole comment, CDATA, or processing instruction, with only
+            // what may be the start of the delimiter kept for a refill
+            const std::string_view delimiter = state.mode == SkipState::COMMENT ? "-->"sv
+                                             : state.mode == SkipState::CDATA ? "]]>"sv : "?>"sv;
+            const std::string_view rest(cursor, cursorEnd - cursor);
+            const auto position = rest.find(delimiter);
+            if (position == std::string_view::npos)
+                return cursorEnd - std::min(rest.size(), delimiter.size() - 1);
+            cursor += position + delimiter.size();
+            state.mode = SkipState::CONTENT;
+            continue;
+        }
+
+        // whole tags in the content, then the markup characters one at a time
+        if (state.mode == SkipState::CONTENT)
+            cursor = skipTags(cursor, cursorEnd, state.level);
+        const char* markup = findMarkup(cursor, cursorEnd);
+        if (markup == cursorEnd) {
+            state.afterSlash = markup != start && markup[-1] == '/';
+            return cursorEnd;
+        }
+        cursor = markup;
+
+        switch (state.mode) {
+        case SkipState::CONTENT:
+            if (*cursor != '<') {
+                // a '>' or quote in the characters
+                ++cursor;
+                break;
+            }
+
+            // the kind of markup, with the '<' kept when it needs more of the buffer
+            if (cursorEnd - cursor < 2)
+                return cursor;
+            if (cursor[1] == '/') {
+                state.mode = SkipState::END_TAG;
+                cursor += 2;
+            } else if (cursor[1] == '?') {
+                state.mode = SkipState::PROCESSING_INSTRUCTION;
+                cursor += 2;
+            } else if (cursor[1] == '!') {
+                if (cursorEnd - cursor < 4)
+                    return cursor;
+                if (cursor[2] == '-' && cursor[3] == '-') {
+                    state.mode = SkipState::COMMENT;
+                    cursor += 4;
+                } else {
+                    if (cursorEnd - cursor < 9)
+                        return cursor;
+                    if (std::string_view(cursor, 9) != "<![CDATA["sv) {
+                        state.mode = SkipState::INVALID;
+                        return cursor;
+                    }
+                    state.mode = SkipState::CDATA;
+                    cursor += 9;
+                }
+            } else {
+                state.mode = SkipState::START_TAG;
+                ++cursor;
+            }
+            break;
+
+        case SkipState::START_TAG:
+            if (*cursor == '>') {
+                // a start tag is nested, unless it is an empty element
+                const bool afterSlash = cursor != start ? cursor[-1] == '/' : state.afterSlash;
+                ++cursor;
+                state.mode = SkipState::CONTENT;
+                if (!afterSlash)
+                    ++state.level;
+                else if (state.level == 0)
+                    return cursor;
+            } else if (*cursor == '"' || *cursor == '\'') {
+                // attribute value, which may have a '>'
+                state.mode = SkipState::QUOTE;
+                state.quote = *cursor;
+                ++cursor;
+            } else {
+                ++cursor;
+            }
+            break;
+
+        case SkipState::END_TAG:
+            ++cursor;
+            if (cursor[-1] == '>') {
+                state.mode = SkipState::CONTENT;
+                if (--state.level == 0)
+                    return cursor;
+            }
+            break;
+
+        case SkipState::QUOTE:
+            if (*cursor == state.quote)
+                state.mode = SkipState::START_TAG;
+            ++cursor;
+            break;
+
+        default:
+            break;
+        }
+    }
+}
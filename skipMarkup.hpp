@@ -0,0 +1,36 @@
+/*
+    skipMarkup.hpp
+
+    Include file for the skipMarkup function
+*/
+
+#ifndef INCLUDED_SKIPMARKUP_HPP
+#define INCLUDED_SKIPMARKUP_HPP
+
+// where skipMarkup is in an element, so a skip can continue after a buffer refill
+struct SkipState {
+    enum Mode { CONTENT, START_TAG, END_TAG, QUOTE, COMMENT, CDATA, PROCESSING_INSTRUCTION, INVALID };
+
+    Mode mode = CONTENT;
+    int level = 1;
+    char quote = 0;
+    bool afterSlash = false;
+};
+
+/*
+    Skip the rest of an element, from its start tag or its content, to
+    just past its end tag. The nesting is counted from the '<', '</', and
+    '/>' of the tags, 16 bytes at a time with SSE2 when the processor has
+    it, and otherwise from the markup characters '<', '>', '"', and '\''
+    one at a time. Comments, CDATA, and processing instructions are
+    skipped whole, and no names are parsed.
+
+    @param[in] cursor Start of the rest of the element
+    @param[in] cursorEnd End of the buffer
+    @param[in, out] state Where the skip is, with level 0 at the end of the element
+    @return Position after the element, or where the skip continues after a refill
+            that keeps [position, cursorEnd), e.g., at a '<' at the end of the buffer
+*/
+const char* skipMarkup(const char* cursor, const char* cursorEnd, SkipState& state);
+
+#endif
@@ -0,0 +1,77 @@
+/*
+    splitChunks.cpp
+
+    Implementation file for splitChunks function
+*/
+
+#include "splitChunks.hpp"
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+// how far before a cut to look for the start of a comment, CDATA, or
+// processing instruction that the cut may be in
+const long LOOKBEHIND_SIZE = 64 * 1024;
+
+/*
+    Split an XML document into about chunkCount chunks of even size,
+    whatever its structure, e.g., one large element. Each chunk after
+    the first starts at a '<' after an even cut, which is a guess at the
+    start of markup. Since '<' cannot be in an attribute value, the guess
+    is only wrong inside a comment, CDATA, or processing instruction, so
+    a '<' inside one that starts shortly before the cut is skipped. The
+    guess is confirmed when the parse of the previous chunk ends outside
+    of markup.
+
+    @param[in] document Complete XML document
+    @param[in] chunkCount Number of chunks to cut the document into
+    @return Views of each chunk in document order, covering the document
+*/
+std::vector<std::string_view> splitChunks(std::string_view document, int chunkCount) {
+    const char* const documentEnd = document.data() + document.size();
+
+    std::vector<const char*> starts = { document.data() };
+    for (int i = 1; i < chunkCount; ++i) {
+        const char* cut = document.data() + static_cast<long>(document.size()) / chunkCount * i;
+        if (cut <= starts.back())
+            continue;
+        cut = static_cast<const char*>(std::memchr(cut, '<', std::distance(cut, documentEnd)));
+        if (cut == nullptr)
+            break;
+
+        // skip to the end of the last comment, CDATA, or processing instruction
+        // that starts before the cut and does not end before it
+        const char* const lookbehind = std::max(starts.back() + 1, cut - LOOKBEHIND_SIZE);
+        const std::string_view before(lookbehind, std::distance(lookbehind, cut));
+        const char* skipTo = nullptr;
+        for (const auto& [startMarkup, endMarkup] : { std::pair("<!--"sv, "-->"sv), std::pair("<![CDATA["sv, "]]>"sv), std::pair("<?"sv, "?>"sv) }) {
+            const auto markupStart = before.rfind(startMarkup);
+            if (markupStart == std::string_view::npos || before.find(endMarkup, markupStart + startMarkup.size()) != std::string_view::npos)
+                continue;
+            const std::string_view after(cut, std::distance(cut, documentEnd));
+            const auto markupEnd = after.find(endMarkup);
+            if (markupEnd == std::string_view::npos)
+                continue;
+            skipTo = std::max(skipTo ? skipTo : cut, cut + markupEnd + endMarkup.size());
+        }
+        if (skipTo) {
+            cut = static_cast<const char*>(std::memchr(skipTo, '<', std::distance(skipTo, documentEnd)));
+            if (cut == nullptr)
+                break;
+        }
+
+        if (cut > starts.back())
+            starts.push_back(cut);
+    }
+
+    std::vector<std::string_view> chunks;
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        const char* const chunkEnd = i + 1 < starts.size() ? starts[i + 1] : documentEnd;
+        chunks.emplace_back(starts[i], std::distance(starts[i], chunkEnd));
+    }
+
+    return chunks;
+}
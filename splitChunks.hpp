@@ -0,0 +1,29 @@
+/*
+    splitChunks.hpp
+
+    Include file for the splitChunks function
+*/
+
+#ifndef INCLUDED_SPLITCHUNKS_HPP
+#define INCLUDED_SPLITCHUNKS_HPP
+
+#include <string_view>
+#include <vector>
+
+/*
+    Split an XML document into about chunkCount chunks of even size,
+    whatever its structure, e.g., one large element. Each chunk after
+    the first starts at a '<' after an even cut, which is a guess at the
+    start of markup. Since '<' cannot be in an attribute value, the guess
+    is only wrong inside a comment, CDATA, or processing instruction, so
+    a '<' inside one that starts shortly before the cut is skipped. The
+    guess is confirmed when the parse of the previous chunk ends outside
+    of markup.
+
+    @param[in] document Complete XML document
+    @param[in] chunkCount Number of chunks to cut the document into
+    @return Views of each chunk in document order, covering the document
+*/
+std::vector<std::string_view> splitChunks(std::string_view document, int chunkCount);
+
+#endif
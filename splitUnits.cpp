@@ -0,0 +1,180 @@
+/*
+    splitUnits.cpp
+
+    Implementation file for splitUnits function
+*/
+
+#include "splitUnits.hpp"
+#include <cstring>
+#include <cctype>
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+/*
+    Scan a srcML archive for its child units, i.e., unit elements at
+    depth 1, by tracking the depth from the start, with no parse of the
+    content. Each unit runs from its start tag to the '>' of its end tag.
+    Comments, CDATA, DOCTYPE, and processing instructions are skipped, so
+    a unit start tag inside of them is not a unit.
+
+    @param[in] document Complete srcML document
+    @param[in] unitStartTag Called with the start tag of each child unit in
+               document order, and returns the length of the unit to skip
+               its content, 0 to scan its content, or std::string_view::npos
+               to stop the scan
+    @param[in] unitFound Called with each whole child unit in document order
+    @return If the scan stopped or reached the end outside of a unit
+    @retval false Unterminated attribute value, or an archive that ends in a unit
+*/
+bool scanUnits(std::string_view document,
+               const std::function<std::size_t(std::string_view startTag)>& unitStartTag,
+               const std::function<void(std::string_view unit)>& unitFound) {
+    const char* const documentEnd = document.data() + document.size();
+    const char* cursor = document.data();
+    int depth = 0;
+
+    // since '<' cannot be in an attribute value, every '<' outside of
+    // comments, CDATA, and processing instructions starts a tag
+    const char* unitStart = nullptr;
+    while ((cursor = static_cast<const char*>(std::memchr(cursor, '<', std::distance(cursor, documentEnd))))) {
+        if (std::distance(cursor, documentEnd) < 2)
+            break;
+        if (cursor[1] == '/') {
+            // end tag, which ends the open child unit when back at depth 1
+            --depth;
+            if (depth == 1 && unitStart) {
+                const char* tagEnd = static_cast<const char*>(std::memchr(cursor, '>', std::distance(cursor, documentEnd)));
+                if (tagEnd == nullptr)
+                    break;
+                unitFound(std::string_view(unitStart, std::distance(unitStart, tagEnd + 1)));
+                unitStart = nullptr;
+                cursor = tagEnd + 1;
+                continue;
+            }
+            cursor += 2;
+            continue;
+        }
+        if (cursor[1] == '!' || cursor[1] == '?') {
+            // comment, CDATA, DOCTYPE, or processing instruction
+            const std::string_view rest(cursor, std::distance(cursor, documentEnd));
+            std::string_view::size_type tagEnd = std::string_view::npos;
+            if (rest.compare(0, 4, "<!--"sv) == 0)
+                tagEnd = rest.find("-->"sv, 4);
+            else if (rest.compare(0, 9, "<![CDATA["sv) == 0)
+                tagEnd = rest.find("]]>"sv, 9);
+            else if (cursor[1] == '?')
+                tagEnd = rest.find("?>"sv, 2);
+            else
+                tagEnd = rest.find('>', 2);
+            if (tagEnd == std::string_view::npos)
+                break;
+            cursor += tagEnd + 1;
+            continue;
+        }
+
+        // start tag of a child of the archive
+        const char* const tagStart = cursor;
+        bool isUnit = false;
+        if (depth == 1) {
+            const char* nameEnd = cursor + 1;
+            while (nameEnd != documentEnd && !isspace(*nameEnd) && *nameEnd != '>' && *nameEnd != '/')
+                ++nameEnd;
+            const std::string_view qName(cursor + 1, std::distance(cursor + 1, nameEnd));
+            const auto colonPosition = qName.find(':');
+            isUnit = qName.substr(colonPosition == std::string_view::npos ? 0 : colonPosition + 1) == "unit"sv;
+        }
+
+        // end of start tag, where a quoted attribute value may contain '>'
+        ++cursor;
+        while (cursor != documentEnd && *cursor != '>') {
+            if (*cursor == '"' || *cursor == '\'') {
+                cursor = static_cast<const char*>(std::memchr(cursor + 1, *cursor, std::distance(cursor + 1, documentEnd)));
+                if (cursor == nullptr)
+                    return false;
+            }
+            ++cursor;
+        }
+        if (cursor == documentEnd)
+            break;
+        ++cursor;
+        const bool emptyElement = cursor[-2] == '/';
+        if (isUnit) {
+            const std::size_t length = unitStartTag(std::string_view(tagStart, std::distance(tagStart, cursor)));
+            if (length == std::string_view::npos)
+                return true;
+            if (length > 0 || emptyElement) {
+                // whole unit, with no scan of its content
+                const std::string_view unit(tagStart, length > 0 ? length : std::distance(tagStart, cursor));
+                unitFound(unit);
+                cursor = tagStart + unit.size();
+                continue;
+            }
+            unitStart = tagStart;
+        }
+        if (!emptyElement)
+            ++depth;
+    }
+
+    return unitStart == nullptr;
+}
+
+/*
+    Split a srcML archive into about chunkCount chunks of whole child
+    units, i.e., unit elements at depth 1. The chunks cover the document
+    from the first child unit to the end, with the archive start tag
+    before them.
+
+    The first child unit is found by scanUnits.
+    Every other chunk starts at the first unit start tag after an even
+    cut of the document, which is only a child unit if it is not nested
+    deeper or inside a comment, CDATA, or processing instruction. So the
+    split is valid when the parse of every chunk but the last, starting
+    at depth 1, ends at depth 1 outside of markup.
+
+    @param[in] document Complete srcML document
+    @param[in] chunkCount Number of chunks to cut the document into
+    @return Views of each chunk in document order
+    @retval empty Not an archive
+*/
+std::vector<std::string_view> splitUnits(std::string_view document, int chunkCount) {
+    const char* const documentEnd = document.data() + document.size();
+
+    // find the first child unit, and stop the scan at its start tag
+    const char* cursor = nullptr;
+    std::string_view unitQName;
+    const bool valid = scanUnits(document, [&](std::string_view startTag) {
+        cursor = startTag.data();
+        unitQName = startTag.substr(1, startTag.find_first_of(" \t\r\n/>", 1) - 1);
+        return std::string_view::npos;
+    }, [](std::string_view) {});
+    if (!valid || unitQName.empty())
+        return std::vector<std::string_view>();
+
+    // start each later chunk at the first unit start tag after an even cut
+    std::vector<const char*> starts = { cursor };
+    const long remaining = std::distance(cursor, documentEnd);
+    const std::string_view rest(cursor, remaining);
+    for (int i = 1; i < chunkCount; ++i) {
+        auto position = static_cast<std::string_view::size_type>(remaining / chunkCount * i);
+        if (position <= static_cast<std::string_view::size_type>(std::distance(cursor, starts.back())) + 1)
+            continue;
+        while ((position = rest.find(unitQName, position)) != std::string_view::npos) {
+            const char next = position + unitQName.size() < rest.size() ? rest[position + unitQName.size()] : '\0';
+            if (position > 0 && rest[position - 1] == '<' && (isspace(next) || next == '>' || next == '/'))
+                break;
+            position += unitQName.size();
+        }
+        if (position == std::string_view::npos)
+            break;
+        starts.push_back(cursor + position - 1);
+    }
+
+    std::vector<std::string_view> chunks;
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        const char* const chunkEnd = i + 1 < starts.size() ? starts[i + 1] : documentEnd;
+        chunks.emplace_back(starts[i], std::distance(starts[i], chunkEnd));
+    }
+
+    return chunks;
+}
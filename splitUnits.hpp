@@ -0,0 +1,55 @@
+/*
+    splitUnits.hpp
+
+    Include file for the splitUnits function
+*/
+
+#ifndef INCLUDED_SPLITUNITS_HPP
+#define INCLUDED_SPLITUNITS_HPP
+
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/*
+    Scan a srcML archive for its child units, i.e., unit elements at
+    depth 1, by tracking the depth from the start, with no parse of the
+    content. Each unit runs from its start tag to the '>' of its end tag.
+    Comments, CDATA, DOCTYPE, and processing instructions are skipped, so
+    a unit start tag inside of them is not a unit.
+
+    @param[in] document Complete srcML document
+    @param[in] unitStartTag Called with the start tag of each child unit in
+               document order, and returns the length of the unit to skip
+               its content, 0 to scan its content, or std::string_view::npos
+               to stop the scan
+    @param[in] unitFound Called with each whole child unit in document order
+    @return If the scan stopped or reached the end outside of a unit
+    @retval false Unterminated attribute value, or an archive that ends in a unit
+*/
+bool scanUnits(std::string_view document,
+               const std::function<std::size_t(std::string_view startTag)>& unitStartTag,
+               const std::function<void(std::string_view unit)>& unitFound);
+
+/*
+    Split a srcML archive into about chunkCount chunks of whole child
+    units, i.e., unit elements at depth 1. The chunks cover the document
+    from the first child unit to the end, with the archive start tag
+    before them.
+
+    The first child unit is found by scanUnits.
+    Every other chunk starts at the first unit start tag after an even
+    cut of the document, which is only a child unit if it is not nested
+    deeper or inside a comment, CDATA, or processing instruction. So the
+    split is valid when the parse of every chunk but the last, starting
+    at depth 1, ends at depth 1 outside of markup.
+
+    @param[in] document Complete srcML document
+    @param[in] chunkCount Number of chunks to cut the document into
+    @return Views of each chunk in document order
+    @retval empty Not an archive
+*/
+std::vector<std::string_view> splitUnits(std::string_view document, int chunkCount);
+
+#endif
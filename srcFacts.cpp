@@ -4,9 +4,54 @@
     Produces a report with various measures of source code.
     Supports C++, C, Java, and C#.
 
-    Input is an XML file in the srcML format.
+    Input is an XML file in the srcML format, either from standard
+    input or from a file given on the command line. The input mode
+    is selected with --input=MODE:
+    * mmap      - memory mapped and parsed in place (default for a file)
+    * readahead - read ahead on a separate thread, so reading from a
+                  pipe overlaps with parsing (default for standard input)
+    * uring     - several reads kept in flight with io_uring, falling
+                  back to read() when io_uring is unavailable
+    * read      - plain read() into a single buffer
+    * feed      - blocks read with read() and pushed to the parser, as
+                  from a socket or another event loop
+    * decompress - gzip, zip (first entry), or zstd decompressed on a
+                  separate thread as it is read (default for a file
+                  ending in .gz, .zip, or .zst)
 
-    Output is a markdown table with the measures.
+    With --threads=N, a document in memory, i.e., with --input=mmap, is
+    parsed in parallel on N threads, by the units of a srcML archive, or
+    speculatively by chunks for any other document.
+
+    With --checkpoint=FILE, a srcML archive with --input=mmap is parsed
+    on one thread with a checkpoint written to FILE between units about
+    every --checkpoint-interval=MB megabytes (by default, 1024). A run
+    that is stopped resumes from the checkpoint when it is run again on
+    the same file, and the checkpoint is removed at the end of the parse.
+
+    With --index=FILE, an index of the units of a srcML archive with
+    --input=mmap is written to FILE, with the offset, length, hash,
+    filename, url, and measures of each unit. With an index, --units=PREFIX
+    parses only the units whose filename starts with PREFIX, and reports on
+    them, when their bytes still have the hash in the index.
+
+    With --cache=FILE, the measures of each unit of a srcML archive with
+    --input=mmap are kept in FILE by the hash of the bytes of the unit,
+    and a later run parses only the units that are not in the cache.
+
+    Given several files, or a directory of them, srcFacts runs in batch
+    mode: the files are parsed in parallel on N threads (by default, one
+    per core), each file on one thread. The .xml, .gz, .zip, and .zst
+    files of a directory and its subdirectories are parsed. The options
+    for a single file, --input, --checkpoint, --index, --units, and
+    --cache, are errors in batch mode, as are unknown options.
+
+    Output is a markdown table with the measures, in batch mode with a
+    row for each file and a row with the total. With --elements, it is
+    followed by a table with the count of each element. With --languages,
+    it is followed by a table with the measures of the files of each
+    language, and with --files, by a table with a row for each file of
+    an archive, by their language and filename attributes.
 
     Output performance statistics to stderr.
 
@@ -27,50 +72,451 @@
 #include <algorithm>
 #include <chrono>
 #include <memory>
+#include <vector>
+#include <filesystem>
+#include <thread>
+#include <cstdint>
 #include <string.h>
-#include "XMLParser.hpp"
+#include <fcntl.h>
+#include <errno.h>
+#include "BasicXMLParser.hpp"
 #include "srcFactsParser.hpp"
+#include "MappedFile.hpp"
+#include "ReadAheadInput.hpp"
+#include "UringInput.hpp"
+#include "DecompressInput.hpp"
+#include "parseUnits.hpp"
+#include "parseCheckpointed.hpp"
+#include "parseIndexedUnits.hpp"
+#include "UnitIndex.hpp"
+#include "parseCached.hpp"
+#include "parseFiles.hpp"
+#include "UnitTable.hpp"
+
+#if !defined(_MSC_VER)
+#include <unistd.h>
+#else
+#include <io.h>
+#define open _open
+#define read _read
+#define dup2 _dup2
+#define close _close
+#endif
 
 // provides literal string operator""sv
 using namespace std::literals::string_view_literals;
 
 const int BUFFER_SIZE = 16 * 16 * 4096;
 
-int main() {
+/*
+    Print a table with the count of each element, from the most frequent
+
+    @param[in] handler Handler with the element counts
+*/
+static void elementReport(srcFactsParser& handler) {
+
+    const ElementNames& names = handler.getElementNames();
+    std::vector<int> nameIDs;
+    for (int nameID = 0; nameID < names.size(); ++nameID) {
+        if (handler.getElementCount(nameID))
+            nameIDs.push_back(nameID);
+    }
+    std::stable_sort(nameIDs.begin(), nameIDs.end(), [&](int left, int right) {
+        return handler.getElementCount(left) > handler.getElementCount(right);
+    });
+    std::cout << "\n| Element | Count |\n";
+    std::cout << "|:--------|------:|\n";
+    for (const int nameID : nameIDs)
+        std::cout << "| " << names.name(nameID) << " | " << handler.getElementCount(nameID) << " |\n";
+}
+
+/*
+    Print a table with the measures of the files of each language, from the
+    most LOC, and a table with the measures of each file
+
+    @param[in] table Measures of each file, e.g., of each unit of an archive
+    @param[in] languageTotals Whether to print the table of languages
+    @param[in] unitRows Whether to print the table of files
+*/
+static void unitReport(const UnitTable& table, bool languageTotals, bool unitRows) {
+
+    // measures in the order of the columns, after the name
+    const auto columns = [](const srcFactsParser::UnitCounts& counts, bool files) {
+        for (int measure = 0; measure < srcFactsParser::UNIT_MEASURES; ++measure) {
+            if (files || measure != srcFactsParser::UNITS)
+                std::cout << " | " << counts[measure];
+        }
+        std::cout << " |\n";
+    };
+    const auto languageName = [&](int language) {
+        return table.languageNames[language].empty() ? std::string_view("-") : std::string_view(table.languageNames[language]);
+    };
+
+    if (languageTotals) {
+        const std::vector<srcFactsParser::UnitCounts> totals = table.languageTotals();
+        std::vector<int> languages;
+        for (int language = 0; language < static_cast<int>(totals.size()); ++language)
+            languages.push_back(language);
+        std::stable_sort(languages.begin(), languages.end(), [&](int left, int right) {
+            return totals[left][srcFactsParser::LOC] > totals[right][srcFactsParser::LOC];
+        });
+        std::cout << "\n| Language | Characters | Files | LOC | Classes | Functions | Declarations"
+                  << " | Expressions | Comments | Returns | Lit Strings | Line Comments |\n";
+        std::cout << "|:---------|";
+        for (int column = 0; column < srcFactsParser::UNIT_MEASURES; ++column)
+            std::cout << "----:|";
+        std::cout << '\n';
+        for (const int language : languages) {
+            std::cout << "| " << languageName(language);
+            columns(totals[language], true);
+        }
+    }
+
+    if (unitRows) {
+        std::cout << "\n| File | Language | Characters | LOC | Classes | Functions | Declarations"
+                  << " | Expressions | Comments | Returns | Lit Strings | Line Comments |\n";
+        std::cout << "|:-----|:---------|";
+        for (int column = 1; column < srcFactsParser::UNIT_MEASURES; ++column)
+            std::cout << "----:|";
+        std::cout << '\n';
+        srcFactsParser::UnitCounts counts;
+        for (std::size_t unit = 0; unit < table.size(); ++unit) {
+            for (int measure = 0; measure < srcFactsParser::UNIT_MEASURES; ++measure)
+                counts[measure] = table.counts[measure][unit];
+            std::cout << "| " << table.filenames[unit] << " | " << languageName(table.languages[unit]);
+            columns(counts, false);
+        }
+    }
+}
+
+/*
+    Print a parser error with its position in the document
+
+    @param[in] error Error of the parse
+*/
+static void errorReport(const XMLParserError& error) {
+    std::cerr << "parser error : " << error.message() << " at line " << error.line << ", column " << error.column << '\n';
+    // the cause of an input error, e.g., of the decompressor
+    if (!error.detail.empty())
+        std::cerr << error.detail << '\n';
+}
+
+/*
+    Parse many srcML files in parallel, and print a row of the report
+    for each file, and a row with the total
+
+    @param[in] filenames Paths of the srcML files
+    @param[in] threadCount Number of worker threads
+    @param[in] elements Whether to print the count of each element
+    @param[in] languageTotals Whether to print the measures of each language
+    @param[in] unitRows Whether to print the measures of each file of the archives
+    @param[in] start Time the program started
+    @return Exit status
+*/
+static int batchFacts(const std::vector<std::string>& filenames, int threadCount, bool elements,
+    bool languageTotals, bool unitRows, std::chrono::steady_clock::time_point start) {
+
+    std::vector<srcFactsParser> handlers;
+    std::vector<std::int64_t> fileBytes;
+    std::vector<XMLParserError> errors;
+    // the tags of a file are gone with its mapping, so only its units are recorded
+    parseFiles(filenames, handlers, fileBytes, errors, threadCount,
+               languageTotals || unitRows ? srcFactsParser::RECORD_UNITS : srcFactsParser::RECORD_NO_UNITS);
+
+    //Print the report
+    std::cout.imbue(std::locale{""});
+    std::cout << "# srcFacts: " << filenames.size() << " files\n";
+    std::cout << "| File | srcML bytes | Characters | Files | LOC | Classes | Functions | Declarations"
+              << " | Expressions | Comments | Returns | Lit Strings | Line Comments |\n";
+    std::cout << "|:-----|";
+    for (int column = 0; column < 12; ++column)
+        std::cout << "----:|";
+    std::cout << '\n';
+    srcFactsParser total;
+    UnitTable table;
+    std::int64_t totalBytes = 0;
+    std::int64_t totalFiles = 0;
+    int status = 0;
+    const auto row = [](std::string_view name, std::int64_t bytes, std::int64_t files, srcFactsParser& handler) {
+        std::cout << "| " << name << " | " << bytes << " | " << handler.getTextsize() << " | " << files
+                  << " | " << handler.getLOC() << " | " << handler.getElementCount(ElementNames::CLASS) << " | " << handler.getElementCount(ElementNames::FUNCTION)
+                  << " | " << handler.getElementCount(ElementNames::DECL) << " | " << handler.getElementCount(ElementNames::EXPR) << " | " << handler.getElementCount(ElementNames::COMMENT)
+                  << " | " << handler.getElementCount(ElementNames::RETURN) << " | " << handler.getLiteralStringCount()
+                  << " | " << handler.getLineCommentCount() << " |\n";
+    };
+    for (std::size_t i = 0; i < filenames.size(); ++i) {
+        if (fileBytes[i] == -1) {
+            std::cerr << "srcFacts: Unable to read file " << filenames[i] << '\n';
+            status = 1;
+            continue;
+        }
+        if (errors[i]) {
+            // the other files are still reported
+            std::cerr << "srcFacts: " << filenames[i] << ": ";
+            errorReport(errors[i]);
+            status = 1;
+            continue;
+        }
+        const std::int64_t files = handlers[i].getElementCount(ElementNames::UNIT) - (handlers[i].getIsArchive() ? 1 : 0);
+        row(filenames[i], fileBytes[i], files, handlers[i]);
+        table.add(handlers[i]);
+        total.merge(handlers[i]);
+        totalBytes += fileBytes[i];
+        totalFiles += files;
+    }
+    row("Total"sv, totalBytes, totalFiles, total);
+    if (elements)
+        elementReport(total);
+    if (languageTotals || unitRows)
+        unitReport(table, languageTotals, unitRows);
+
+    const auto finish = std::chrono::steady_clock::now();
+    const auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double> >(finish - start).count();
+    std::clog << '\n';
+    std::clog << std::setprecision(3) << elapsed_seconds << " sec\n";
+    std::clog << std::setprecision(3) << total.getLOC() / elapsed_seconds / 1000000 << " MLOC/sec\n";
+
+    return status;
+}
+
+int main(int argc, char* argv[]) {
     const auto start = std::chrono::steady_clock::now();
-    std::string buffer(BUFFER_SIZE, ' ');
 
-    //Construct a handler and parser object
+    //Process the command line
+    std::string_view inputMode;
+    std::vector<std::string> filenames;
+    bool isBatch = false;
+    bool elements = false;
+    bool languageTotals = false;
+    bool unitRows = false;
+    int threadCount = 0;
+    std::string checkpointPath;
+    std::int64_t checkpointInterval = 1024;
+    std::string indexPath;
+    std::string_view unitPrefix;
+    bool selectUnits = false;
+    std::string cachePath;
+    // options of a single document, which batch mode does not have
+    std::string singleOptions;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        const std::string_view option = arg.substr(0, arg.find('=') + 1);
+        if (option == "--input="sv || option == "--checkpoint="sv || option == "--checkpoint-interval="sv
+            || option == "--index="sv || option == "--units="sv || option == "--cache="sv)
+            singleOptions.append(singleOptions.empty() ? "" : ", ").append(option.substr(0, option.size() - 1));
+        if (option == "--input="sv) {
+            inputMode = arg.substr(8);
+        } else if (option == "--threads="sv) {
+            threadCount = std::max(1, atoi(argv[i] + 10));
+        } else if (option == "--checkpoint="sv) {
+            checkpointPath = arg.substr(13);
+        } else if (option == "--checkpoint-interval="sv) {
+            checkpointInterval = std::max(1LL, atoll(argv[i] + 22));
+        } else if (option == "--index="sv) {
+            indexPath = arg.substr(8);
+        } else if (option == "--units="sv) {
+            unitPrefix = arg.substr(8);
+            selectUnits = true;
+        } else if (option == "--cache="sv) {
+            cachePath = arg.substr(8);
+        } else if (arg == "--elements"sv) {
+            elements = true;
+        } else if (arg == "--languages"sv) {
+            languageTotals = true;
+        } else if (arg == "--files"sv) {
+            unitRows = true;
+        } else if (arg.substr(0, 2) == "--"sv) {
+            // not taken as a filename, which would give a report that looks normal
+            std::cerr << "srcFacts: Unknown option " << arg << '\n';
+            return 1;
+        } else if (std::error_code error; std::filesystem::is_directory(argv[i], error)) {
+            // srcML files of the directory, in a repeatable order
+            isBatch = true;
+            std::vector<std::string> directoryFiles;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(argv[i],
+                std::filesystem::directory_options::skip_permission_denied, error)) {
+                const auto extension = entry.path().extension();
+                if (entry.is_regular_file(error) && (extension == ".xml" || DecompressInput::isCompressed(entry.path().string())))
+                    directoryFiles.push_back(entry.path().string());
+            }
+            std::sort(directoryFiles.begin(), directoryFiles.end());
+            filenames.insert(filenames.end(), directoryFiles.begin(), directoryFiles.end());
+        } else {
+            filenames.push_back(argv[i]);
+        }
+    }
+    if ((isBatch || filenames.size() > 1) && !singleOptions.empty()) {
+        std::cerr << "srcFacts: Batch mode does not work with the options for a single file: " << singleOptions << '\n';
+        return 1;
+    }
+    if (isBatch || filenames.size() > 1)
+        return batchFacts(filenames, threadCount ? threadCount : std::max(1U, std::thread::hardware_concurrency()), elements,
+                          languageTotals, unitRows, start);
+    const char* filename = filenames.empty() ? nullptr : filenames.front().c_str();
+    threadCount = std::max(1, threadCount);
+    const bool inputChosen = !inputMode.empty();
+    if (inputMode.empty() && filename && DecompressInput::isCompressed(filename))
+        inputMode = "decompress"sv;
+    if (inputMode.empty())
+        inputMode = filename ? "mmap"sv : "readahead"sv;
+    if (inputMode == "decompress"sv && filename && !DecompressInput::isSupported(filename)) {
+        std::cerr << "srcFacts: Built without the library to decompress " << filename << '\n';
+        return 1;
+    }
+    if (inputMode != "mmap"sv && inputMode != "readahead"sv && inputMode != "uring"sv && inputMode != "read"sv
+        && inputMode != "feed"sv && inputMode != "decompress"sv) {
+        std::cerr << "srcFacts: Unknown input mode " << inputMode << '\n';
+        return 1;
+    }
+    if (selectUnits && indexPath.empty()) {
+        std::cerr << "srcFacts: --units needs the --index of the file\n";
+        return 1;
+    }
+    // a file that is read, not mapped, is parsed on one thread, e.g., a compressed one
+    if (threadCount > 1 && ((inputChosen && inputMode != "mmap"sv) || !checkpointPath.empty() || selectUnits || !cachePath.empty())) {
+        std::cerr << "srcFacts: --threads needs --input=mmap, with no checkpoint, units, or cache\n";
+        return 1;
+    }
+    if ((!indexPath.empty() || selectUnits) && (inputMode != "mmap"sv || !checkpointPath.empty())) {
+        std::cerr << "srcFacts: An index needs --input=mmap, with no checkpoint\n";
+        return 1;
+    }
+    if (!cachePath.empty() && (inputMode != "mmap"sv || !checkpointPath.empty() || !indexPath.empty() || elements)) {
+        std::cerr << "srcFacts: A cache needs --input=mmap, with no checkpoint, index, or --elements\n";
+        return 1;
+    }
+    if ((languageTotals || unitRows) && (!cachePath.empty() || !checkpointPath.empty())) {
+        std::cerr << "srcFacts: The measures of each file need a parse with no cache or checkpoint\n";
+        return 1;
+    }
+
+    //Map the input file, or make it standard input for the other modes
+    std::unique_ptr<MappedFile> file;
+    if (inputMode == "mmap"sv) {
+        file = std::make_unique<MappedFile>(filename ? filename : "/dev/stdin");
+        if (!file->isValid()) {
+            std::cerr << "srcFacts: Unable to map file " << (filename ? filename : "standard input") << '\n';
+            return 1;
+        }
+    } else if (filename) {
+        const int fd = open(filename, O_RDONLY);
+        if (fd == -1 || dup2(fd, 0) == -1) {
+            std::cerr << "srcFacts: Unable to open file " << filename << '\n';
+            return 1;
+        }
+        close(fd);
+    }
+
+    //Construct a handler, and parse the document in memory, or with a parser on the input
     srcFactsParser handler;
-    XMLParser parser(handler, buffer);
+    // the tags of the units only for an index, which needs the file in memory
+    if (!indexPath.empty() && !selectUnits)
+        handler.setUnitRecording(srcFactsParser::RECORD_UNIT_TAGS);
+    else if (languageTotals || unitRows)
+        handler.setUnitRecording(srcFactsParser::RECORD_UNITS);
+    std::int64_t totalBytes = 0;
+    XMLParserError error;
+    bool saved = true;
+    if (file && selectUnits) {
+        // only the selected units, found with the index instead of a parse of the archive
+        UnitIndex index;
+        if (indexPath.empty() || !index.load(indexPath) || !index.matches(file->view(), unitPrefix)) {
+            std::cerr << "srcFacts: No index of " << (filename ? filename : "standard input") << " in " << indexPath << '\n';
+            return 1;
+        }
+        totalBytes = parseIndexedUnits(file->view(), index, unitPrefix, handler, error);
+    } else if (file && !cachePath.empty()) {
+        totalBytes = parseCached(file->view(), handler, cachePath, saved, error);
+        if (!saved)
+            std::cerr << "srcFacts: Unable to write cache " << cachePath << '\n';
+    } else if (file && !checkpointPath.empty()) {
+        totalBytes = parseCheckpointed(file->view(), handler, checkpointPath, checkpointInterval * 1024 * 1024, saved, error);
+        if (!saved)
+            std::cerr << "srcFacts: Unable to write checkpoint " << checkpointPath << '\n';
+    } else if (file) {
+        totalBytes = parseUnits(file->view(), handler, threadCount, error);
+    } else if (inputMode == "feed"sv) {
+        // each block is parsed in place, and reused for the next read
+        std::unique_ptr<char[]> buffer(new char[BUFFER_SIZE]);
+        BasicXMLParser<srcFactsParser> parser(handler, std::string_view());
+        long bytesRead = 0;
+        while (!error) {
+            while (((bytesRead = read(0, buffer.get(), BUFFER_SIZE)) == -1) && (errno == EINTR)) {
+            }
+            if (bytesRead <= 0)
+                break;
+            error = parser.feed(buffer.get(), bytesRead);
+        }
+        if (!error)
+            error = bytesRead == -1 ? XMLParserError{XMLParserError::INPUT_ERROR} : parser.finish();
+        totalBytes = parser.getTotalBytes();
+    } else {
+        std::unique_ptr<XMLParserInput> input;
+        std::unique_ptr<char[]> buffer;
+        std::unique_ptr<BasicXMLParser<srcFactsParser>> parser;
+        if (inputMode == "read"sv) {
+            // parsed in place, with no copy or initialization of the buffer
+            buffer.reset(new char[BUFFER_SIZE]);
+            parser = std::make_unique<BasicXMLParser<srcFactsParser>>(handler, buffer.get(), BUFFER_SIZE);
+        } else {
+            if (inputMode == "uring"sv) {
+                auto uringInput = std::make_unique<UringInput>(0, BUFFER_SIZE);
+                if (!uringInput->isUring())
+                    std::clog << "srcFacts: io_uring is unavailable, using read()\n";
+                input = std::move(uringInput);
+            } else if (inputMode == "decompress"sv) {
+                input = std::make_unique<DecompressInput>(0, BUFFER_SIZE);
+            } else {
+                input = std::make_unique<ReadAheadInput>(0, BUFFER_SIZE);
+            }
+            parser = std::make_unique<BasicXMLParser<srcFactsParser>>(handler, *input);
+        }
+        error = parser->parse();
+        totalBytes = parser->getTotalBytes();
+    }
+    if (error) {
+        errorReport(error);
+        return 1;
+    }
 
-    //Parse the document
-    parser.parse();
+    //Write the index of the units of the archive
+    if (!indexPath.empty() && !selectUnits && !UnitIndex(file->view(), handler).save(indexPath))
+        std::cerr << "srcFacts: Unable to write index " << indexPath << '\n';
 
     //Print the report
     const auto finish = std::chrono::steady_clock::now();
     const auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double> >(finish - start).count();
     const double mlocPerSec = handler.getLOC() / elapsed_seconds / 1000000;
-    int files = handler.getUnitCount();
-    if (handler.getIsArchive())
+    std::int64_t files = handler.getElementCount(ElementNames::UNIT);
+    // the root unit of an archive, also when no unit is selected from its index
+    if (handler.getIsArchive() || selectUnits)
         --files;
     std::cout.imbue(std::locale{""});
-    int valueWidth = std::max(5, static_cast<int>(log10(parser.getTotalBytes()) * 1.3 + 1));
+    // width of the largest value, the number of bytes, with room for digit separators
+    const double largestValue = static_cast<double>(std::max<std::int64_t>(totalBytes, 1));
+    const int valueWidth = std::max(5, static_cast<int>(std::log10(largestValue) * 1.3 + 1));
     std::cout << "# srcFacts: " << handler.getURL() << '\n';
     std::cout << "| Measure      | " << std::setw(valueWidth + 3) << "Value |\n";
     std::cout << "|:-------------|-" << std::setw(valueWidth + 3) << std::setfill('-') << ":|\n" << std::setfill(' ');
-    std::cout << "| srcML bytes  | " << std::setw(valueWidth) << parser.getTotalBytes() << " |\n";
+    std::cout << "| srcML bytes  | " << std::setw(valueWidth) << totalBytes << " |\n";
     std::cout << "| Characters   | " << std::setw(valueWidth) << handler.getTextsize()       << " |\n";
     std::cout << "| Files        | " << std::setw(valueWidth) << files          << " |\n";
     std::cout << "| LOC          | " << std::setw(valueWidth) << handler.getLOC()            << " |\n";
-    std::cout << "| Classes      | " << std::setw(valueWidth) << handler.getClassCount()    << " |\n";
-    std::cout << "| Functions    | " << std::setw(valueWidth) << handler.getFunctionCount() << " |\n";
-    std::cout << "| Declarations | " << std::setw(valueWidth) << handler.getDeclCount()     << " |\n";
-    std::cout << "| Expressions  | " << std::setw(valueWidth) << handler.getExprCount()     << " |\n";
-    std::cout << "| Comments     | " << std::setw(valueWidth) << handler.getCommentCount()  << " |\n";
-    std::cout << "| Returns      | " << std::setw(valueWidth) << handler.getReturnCount()  << " |\n";
+    std::cout << "| Classes      | " << std::setw(valueWidth) << handler.getElementCount(ElementNames::CLASS)    << " |\n";
+    std::cout << "| Functions    | " << std::setw(valueWidth) << handler.getElementCount(ElementNames::FUNCTION) << " |\n";
+    std::cout << "| Declarations | " << std::setw(valueWidth) << handler.getElementCount(ElementNames::DECL)     << " |\n";
+    std::cout << "| Expressions  | " << std::setw(valueWidth) << handler.getElementCount(ElementNames::EXPR)     << " |\n";
+    std::cout << "| Comments     | " << std::setw(valueWidth) << handler.getElementCount(ElementNames::COMMENT)  << " |\n";
+    std::cout << "| Returns      | " << std::setw(valueWidth) << handler.getElementCount(ElementNames::RETURN)  << " |\n";
     std::cout << "| Lit Strings  | " << std::setw(valueWidth) << handler.getLiteralStringCount()  << " |\n";
     std::cout << "| Line Comments| " << std::setw(valueWidth) << handler.getLineCommentCount()  << " |\n";
+    if (elements)
+        elementReport(handler);
+    if (languageTotals || unitRows) {
+        UnitTable table;
+        table.add(handler);
+        unitReport(table, languageTotals, unitRows);
+    }
     std::clog << '\n';
     std::clog << std::setprecision(3) << elapsed_seconds << " sec\n";
     std::clog << std::setprecision(3) << mlocPerSec << " MLOC/sec\n";
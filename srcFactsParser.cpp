@@ -8,6 +8,8 @@
 
 #include "srcFactsParser.hpp"
 #include <algorithm>
+#include <istream>
+#include <ostream>
 
 // provides literal string operator""sv
 using namespace std::literals::string_view_literals;
@@ -19,29 +21,47 @@ using namespace std::literals::string_view_literals;
     Output: N/A
 */
 void srcFactsParser::handleElementStartTag(std::string_view qName, std::string_view prefix, std::string_view localName, const int &depth){
+    handleElementStartTag(qName, prefix, localName, ElementNames::find(qName), depth);
+}
+
+/*
+    Function that handles
+    element start tags, with the ID of the element name
+    Input: std::string_view qName, std::string_view prefix, std::string_view localName, int nameID, int depth
+    Output: N/A
+*/
+void srcFactsParser::handleElementStartTag(std::string_view qName, std::string_view prefix, std::string_view localName, int nameID, const int &depth){
     inTagLiteral = false;
     inTagComment = false;
-    if (localName == "expr"sv) {
-        ++exprCount;
-    } else if (localName == "decl"sv) {
-        ++declCount;
-    } else if (localName == "comment"sv) {
-        ++commentCount;
-    } else if (localName == "function"sv) {
-        ++functionCount;
-    } else if (localName == "unit"sv) {
-        ++unitCount;
+    inUnitTag = false;
+
+    // a name outside the vocabulary has an ID of this handler, interned by
+    // the parser, or here for a parser that only finds the vocabulary
+    if (nameID < 0 || nameID >= ElementNames::VOCABULARY_SIZE) {
+        if (nameID < 0)
+            nameID = elementNames.intern(qName);
+        if (nameID >= static_cast<int>(elementCounts.size()))
+            elementCounts.resize(nameID + 1);
+    }
+    ++elementCounts[nameID];
+
+    switch (nameID) {
+    case ElementNames::UNIT:
         if (depth == 1)
             isArchive = true;
-    } else if (localName == "class"sv) {
-        ++classCount;
-    } else if (localName == "return"sv) {
-        ++returnCount;
-    }
-    if (localName == "literal"sv) {
+        unitDepth = std::min(unitDepth, depth);
+        // the tag is the '<' before the name in the parsed document
+        if (unitRecording != RECORD_NO_UNITS)
+            startUnit(qName.data() - 1, depth);
+        break;
+    case ElementNames::LITERAL:
         inTagLiteral = true;
-    } else if (localName == "comment"sv) {
+        break;
+    case ElementNames::COMMENT:
         inTagComment = true;
+        break;
+    default:
+        break;
     }
 
     return;
@@ -50,16 +70,14 @@ void srcFactsParser::handleElementStartTag(std::string_view qName, std::string_v
 /*
     Override function that handles
     characters
-    Input: std::string_view characters, int depth
+    Input: std::string_view characters, int newlineCount, int depth
     Output: N/A
 */
-void srcFactsParser::handleCharacters(std::string_view characters, const int &depth){
-    if (characters == "<"sv || characters == ">"sv || characters == "&"sv) {
-        ++textsize;
-    } else {
-        loc += static_cast<int>(std::count(characters.cbegin(), characters.cend(), '\n'));
-        textsize += static_cast<int>(characters.size());
-    }
+void srcFactsParser::handleCharacters(std::string_view characters, const int &newlineCount, const int &depth){
+    loc += newlineCount;
+    textsize += static_cast<std::int64_t>(characters.size());
+    if (depth <= rootDepth)
+        addRootText(depth, static_cast<std::int64_t>(characters.size()), newlineCount);
 
     return;
 }
@@ -73,6 +91,14 @@ void srcFactsParser::handleCharacters(std::string_view characters, const int &de
 void srcFactsParser::handleAttribute(std::string_view qName, std::string_view prefix, std::string_view localName, std::string_view value, const int &depth){
     if (localName == "url"sv)
         url = value;
+    if (inUnitTag) {
+        if (localName == "filename"sv)
+            units.filenames.back() = value;
+        else if (localName == "url"sv)
+            units.urls.back() = value;
+        else if (localName == "language"sv)
+            units.languages.back() = languageID(value);
+    }
     if (inTagLiteral) {
         if (localName == "type"sv && value == "string"sv) {
             ++literalStringCount;
@@ -95,8 +121,11 @@ void srcFactsParser::handleAttribute(std::string_view qName, std::string_view pr
     Output: N/A
 */
 void srcFactsParser::handleCDATA(std::string_view content, const int &depth){
-    textsize += static_cast<int>(content.size());
-    loc += static_cast<int>(std::count(content.begin(), content.end(), '\n'));
+    const std::int64_t newlineCount = static_cast<std::int64_t>(std::count(content.begin(), content.end(), '\n'));
+    textsize += static_cast<std::int64_t>(content.size());
+    loc += newlineCount;
+    if (depth <= rootDepth)
+        addRootText(depth, static_cast<std::int64_t>(content.size()), newlineCount);
 
     return;
 }
@@ -171,6 +200,130 @@ void srcFactsParser::handleEndDocument(const int &depth){
 
 }
 
+/*
+    Adds the counts of another handler, e.g., one that parsed
+    the next part of the same document on another thread, at
+    depths that differ from the real ones by the depth offset
+    Input: Handler to merge and its depth offset
+    Output: Updated counts
+*/
+void srcFactsParser::merge(const srcFactsParser &other, int depthOffset){
+    // the units of the other handler follow the counts of this one, with
+    // the languages by name
+    const UnitCounts counts = getChildUnitCounts();
+    units.tags.insert(units.tags.end(), other.units.tags.begin(), other.units.tags.end());
+    for (const int depth : other.units.depths)
+        units.depths.push_back(depth + depthOffset);
+    units.filenames.insert(units.filenames.end(), other.units.filenames.begin(), other.units.filenames.end());
+    units.urls.insert(units.urls.end(), other.units.urls.begin(), other.units.urls.end());
+    for (const int otherID : other.units.languages)
+        units.languages.push_back(languageID(other.units.languageNames[otherID]));
+    for (int measure = 0; measure < UNIT_MEASURES; ++measure) {
+        for (const auto count : other.units.before[measure])
+            units.before[measure].push_back(count + counts[measure]);
+    }
+    if (!other.url.empty())
+        url = other.url;
+    textsize += other.textsize;
+    loc += other.loc;
+    // the shallowest characters of the other handler at their real depth
+    if (other.rootDepth != std::numeric_limits<int>::max())
+        addRootText(other.rootDepth + depthOffset, other.rootTextsize, other.rootLOC);
+    // the vocabulary has the same IDs in every handler, and other names are added by name
+    for (int nameID = 0; nameID < ElementNames::VOCABULARY_SIZE; ++nameID)
+        elementCounts[nameID] += other.elementCounts[nameID];
+    for (int otherID = ElementNames::VOCABULARY_SIZE; otherID < other.elementNames.size(); ++otherID) {
+        const int nameID = elementNames.intern(other.elementNames.name(otherID));
+        if (nameID >= static_cast<int>(elementCounts.size()))
+            elementCounts.resize(nameID + 1);
+        elementCounts[nameID] += other.elementCounts[otherID];
+    }
+    literalStringCount += other.literalStringCount;
+    lineCommentCount += other.lineCommentCount;
+    // a part parsed at other depths cannot have the root unit, so it
+    // has a unit at depth 1 only if its shallowest unit is at depth 1
+    isArchive = isArchive || other.isArchive;
+    if (other.unitDepth != std::numeric_limits<int>::max()) {
+        isArchive = isArchive || other.unitDepth + depthOffset == 1;
+        unitDepth = std::min(unitDepth, other.unitDepth + depthOffset);
+    }
+
+    return;
+}
+
+/*
+    Writes the counts, e.g., to a checkpoint of a long parse between
+    units, where no tag is open in the handler
+    Input: Output stream
+    Output: Counts as text, with the elements by name
+*/
+void srcFactsParser::save(std::ostream &out) const{
+    out << url << '\n'
+        << textsize << ' ' << loc << ' ' << literalStringCount << ' ' << lineCommentCount << ' '
+        << isArchive << ' ' << unitDepth << '\n';
+    // by name, since the IDs of other names depend on the order they were seen
+    out << std::count_if(elementCounts.begin(), elementCounts.end(), [](std::int64_t count) { return count != 0; }) << '\n';
+    for (int nameID = 0; nameID < static_cast<int>(elementCounts.size()); ++nameID) {
+        if (elementCounts[nameID] != 0)
+            out << elementNames.name(nameID) << ' ' << elementCounts[nameID] << '\n';
+    }
+
+    return;
+}
+
+/*
+    Reads the counts written by save, in place of the current ones
+    Input: Input stream
+    Output: Restored counts; bool value for whether they were read
+*/
+bool srcFactsParser::restore(std::istream &in){
+    srcFactsParser restored;
+    std::int64_t nameCount = 0;
+    std::getline(in, restored.url);
+    in >> restored.textsize >> restored.loc >> restored.literalStringCount >> restored.lineCommentCount
+       >> restored.isArchive >> restored.unitDepth >> nameCount;
+    for (std::int64_t i = 0; i < nameCount && in; ++i) {
+        std::string qName;
+        std::int64_t count = 0;
+        if (!(in >> qName >> count))
+            break;
+        const int nameID = restored.elementNames.intern(qName);
+        if (nameID >= static_cast<int>(restored.elementCounts.size()))
+            restored.elementCounts.resize(nameID + 1);
+        restored.elementCounts[nameID] = count;
+    }
+    if (!in)
+        return false;
+    restored.unitRecording = unitRecording;
+    *this = std::move(restored);
+
+    return true;
+}
+
+/*
+    Adds the measures of a child unit of an archive that is not parsed,
+    e.g., one with its measures in a cache
+    Input: Counts of each UnitMeasure of the unit
+    Output: Updated counts
+*/
+void srcFactsParser::addUnit(const UnitCounts &counts){
+    textsize += counts[TEXTSIZE];
+    loc += counts[LOC];
+    elementCounts[ElementNames::UNIT] += counts[UNITS];
+    elementCounts[ElementNames::CLASS] += counts[CLASSES];
+    elementCounts[ElementNames::FUNCTION] += counts[FUNCTIONS];
+    elementCounts[ElementNames::DECL] += counts[DECLARATIONS];
+    elementCounts[ElementNames::EXPR] += counts[EXPRESSIONS];
+    elementCounts[ElementNames::COMMENT] += counts[COMMENTS];
+    elementCounts[ElementNames::RETURN] += counts[RETURNS];
+    literalStringCount += counts[LITERAL_STRINGS];
+    lineCommentCount += counts[LINE_COMMENTS];
+    isArchive = true;
+    unitDepth = std::min(unitDepth, 1);
+
+    return;
+}
+
 /*
     Get method for URL
     Input: N/A
@@ -185,7 +338,7 @@ std::string srcFactsParser::getURL(){
     Input: N/A
     Output: Textsize
 */
-int srcFactsParser::getTextsize(){
+std::int64_t srcFactsParser::getTextsize(){
     return textsize;
 }
 
@@ -194,96 +347,170 @@ int srcFactsParser::getTextsize(){
     Input: N/A
     Output: LOC
 */
-int srcFactsParser::getLOC(){
+std::int64_t srcFactsParser::getLOC(){
     return loc;
 }
 
 /*
-    Get method for ExprCount
-    Input: N/A
-    Output: ExprCount
+    Get method for the count of an element
+    Input: ID of the element name, e.g., ElementNames::EXPR
+    Output: Number of start tags of the element
 */
-int srcFactsParser::getExprCount(){
-    return exprCount;
+std::int64_t srcFactsParser::getElementCount(int nameID){
+    return nameID >= 0 && nameID < static_cast<int>(elementCounts.size()) ? elementCounts[nameID] : 0;
 }
 
 /*
-    Get method for FunctionCount
+    Get method for ElementNames, the names of the IDs of the element counts
     Input: N/A
-    Output: FunctionCount
+    Output: ElementNames
 */
-int srcFactsParser::getFunctionCount(){
-    return functionCount;
+const ElementNames& srcFactsParser::getElementNames(){
+    return elementNames;
 }
 
 /*
-    Get method for ClassCount
+    Get method for LiteralStringCount
     Input: N/A
-    Output: ClassCount
+    Output: LiteralStringCount
 */
-int srcFactsParser::getClassCount(){
-    return classCount;
+std::int64_t srcFactsParser::getLiteralStringCount(){
+    return literalStringCount;
 }
 
 /*
-    Get method for UnitCount
+    Get method for LineCommentCount
     Input: N/A
-    Output: UnitCount
+    Output: LineCommentCount
 */
-int srcFactsParser::getUnitCount(){
-    return unitCount;
+std::int64_t srcFactsParser::getLineCommentCount(){
+    return lineCommentCount;
 }
 
 /*
-    Get method for DeclCount
+    Get method for IsArchive
     Input: N/A
-    Output: DeclCount
+    Output: IsArchive
 */
-int srcFactsParser::getDeclCount(){
-    return declCount;
+bool srcFactsParser::getIsArchive(){
+    return isArchive;
 }
 
 /*
-    Get method for CommentCount
+    Get method for the measures of the report counted so far
     Input: N/A
-    Output: CommentCount
+    Output: Counts of each UnitMeasure
 */
-int srcFactsParser::getCommentCount(){
-    return commentCount;
+srcFactsParser::UnitCounts srcFactsParser::getUnitCounts(){
+    return UnitCounts{ textsize, elementCounts[ElementNames::UNIT], loc, elementCounts[ElementNames::CLASS], elementCounts[ElementNames::FUNCTION],
+                       elementCounts[ElementNames::DECL], elementCounts[ElementNames::EXPR], elementCounts[ElementNames::COMMENT],
+                       elementCounts[ElementNames::RETURN], literalStringCount, lineCommentCount };
 }
 
 /*
-    Get method for ReturnCount
+    Get method for the measures of the report counted so far in the
+    child units of the root element, i.e., without its own characters
     Input: N/A
-    Output: ReturnCount
+    Output: Counts of each UnitMeasure
 */
-int srcFactsParser::getReturnCount(){
-    return returnCount;
+srcFactsParser::UnitCounts srcFactsParser::getChildUnitCounts(){
+    UnitCounts counts = getUnitCounts();
+    counts[TEXTSIZE] -= rootTextsize;
+    counts[LOC] -= rootLOC;
+
+    return counts;
 }
 
 /*
-    Get method for LiteralStringCount
-    Input: N/A
-    Output: LiteralStringCount
+    Set method for the units that are recorded, so a parse with
+    no index or measures of each file records none
+    Input: Units to record
+    Output: N/A
 */
-int srcFactsParser::getLiteralStringCount(){
-    return literalStringCount;
+void srcFactsParser::setUnitRecording(UnitRecording recording){
+    unitRecording = recording;
 }
 
 /*
-    Get method for LineCommentCount
+    Get method for the units that are recorded
     Input: N/A
-    Output: LineCommentCount
+    Output: UnitRecording
 */
-int srcFactsParser::getLineCommentCount(){
-    return lineCommentCount;
+srcFactsParser::UnitRecording srcFactsParser::getUnitRecording(){
+    return unitRecording;
 }
 
 /*
-    Get method for IsArchive
+    Get method for the start tags of the units, in document order,
+    as recorded by setUnitRecording, whose tags are in the parsed
+    document only while it is in memory
     Input: N/A
-    Output: IsArchive
+    Output: Start of each unit
 */
-bool srcFactsParser::getIsArchive(){
-    return isArchive;
+const srcFactsParser::UnitStarts& srcFactsParser::getUnits(){
+    return units;
+}
+
+/*
+    Adds the start tag of a unit, with the counts before it, whose
+    attributes are added as they are found
+    Input: Start of the tag in the parsed document, and its depth
+    Output: Added unit
+*/
+void srcFactsParser::startUnit(const char* tag, int depth){
+    // a tag of a streaming input is gone after the next refill
+    units.tags.push_back(unitRecording == RECORD_UNIT_TAGS ? tag : nullptr);
+    units.depths.push_back(depth);
+    units.filenames.emplace_back();
+    units.urls.emplace_back();
+    units.languages.push_back(languageID(""sv));
+    // the characters around a unit are at its depth, so the counts of
+    // the units at the shallowest depth are without the space between them,
+    // also in a chunk parsed at a guessed depth
+    if (depth > 0)
+        addRootText(depth, 0, 0);
+    // the unit itself is already counted
+    UnitCounts counts = getChildUnitCounts();
+    --counts[UNITS];
+    for (int measure = 0; measure < UNIT_MEASURES; ++measure)
+        units.before[measure].push_back(counts[measure]);
+    inUnitTag = true;
+
+    return;
+}
+
+/*
+    Adds characters to those at the shallowest depth, which starts
+    over at a shallower depth
+    Input: Depth of the characters, their size, and their newlines
+    Output: Updated counts of the shallowest characters
+*/
+void srcFactsParser::addRootText(int depth, std::int64_t size, std::int64_t newlineCount){
+    if (depth > rootDepth)
+        return;
+    if (depth < rootDepth) {
+        rootDepth = depth;
+        rootTextsize = 0;
+        rootLOC = 0;
+    }
+    rootTextsize += size;
+    rootLOC += newlineCount;
+
+    return;
+}
+
+/*
+    Finds the ID of the name of a language, e.g., from the language
+    attribute of a unit, and adds the name the first time it is found
+    Input: Name of the language
+    Output: ID of the name
+*/
+int srcFactsParser::languageID(std::string_view language){
+    // only a few languages, so a search is faster than a map
+    const auto found = std::find(units.languageNames.begin(), units.languageNames.end(), language);
+    if (found != units.languageNames.end())
+        return static_cast<int>(std::distance(units.languageNames.begin(), found));
+    units.languageNames.emplace_back(language);
+
+    return static_cast<int>(units.languageNames.size()) - 1;
 }
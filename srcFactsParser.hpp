@@ -9,25 +9,101 @@
 #ifndef SRCFACTSPARSER_HPP
 #define SRCFACTSPARSER_HPP
 
+#include <string>
+#include <limits>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <iosfwd>
 #include "XMLParserHandler.hpp"
+#include "ElementNames.hpp"
+
+template <class Handler>
+class BasicXMLParser;
+
+// final, so a BasicXMLParser<srcFactsParser> calls the handlers directly
+class srcFactsParser final : public XMLParserHandler {
+public:
+    // measures of the report that are counted for each unit of an archive
+    enum UnitMeasure { TEXTSIZE, UNITS, LOC, CLASSES, FUNCTIONS, DECLARATIONS, EXPRESSIONS, COMMENTS, RETURNS,
+                       LITERAL_STRINGS, LINE_COMMENTS, UNIT_MEASURES };
+    typedef std::array<std::int64_t, UNIT_MEASURES> UnitCounts;
+
+    // units recorded in UnitStarts, for the measures of each file, and with
+    // their start tags for the index of a document in memory
+    enum UnitRecording { RECORD_NO_UNITS, RECORD_UNITS, RECORD_UNIT_TAGS };
+
+    // start tags of the units, with the counts of the child units of the
+    // root before each, so the counts of a child unit of an archive are the
+    // difference to the next, as a struct of arrays, so a column of every
+    // unit is contiguous
+    struct UnitStarts {
+        // in the parsed document, e.g., a MappedFile, or nullptr with no RECORD_UNIT_TAGS
+        std::vector<const char*> tags;
+        std::vector<int> depths;
+        std::vector<std::string> filenames;
+        std::vector<std::string> urls;
+        // ID of the language attribute, an index into languageNames
+        std::vector<int> languages;
+        std::array<std::vector<std::int64_t>, UNIT_MEASURES> before;
+        std::vector<std::string> languageNames;
+    };
 
-class srcFactsParser : public XMLParserHandler {
 private:
+    // calls the private handlers
+    template <class Handler>
+    friend class BasicXMLParser;
+
     std::string url;
-    int textsize = 0;
-    int loc = 0;
-    int exprCount = 0;
-    int functionCount = 0;
-    int classCount = 0;
-    int unitCount = 0;
-    int declCount = 0;
-    int commentCount = 0;
-    int returnCount = 0;
-    int literalStringCount = 0;
-    int lineCommentCount = 0;
+    // 64-bit, for documents of many GB
+    std::int64_t textsize = 0;
+    std::int64_t loc = 0;
+    // characters at the shallowest depth of the parse below the root, which
+    // is depth 1 for those directly in the root element, e.g., the space
+    // between the units of an archive, which are in the counts of no child
+    // unit. A chunk parsed at a guessed depth has its real depth when merged
+    int rootDepth = std::numeric_limits<int>::max();
+    std::int64_t rootTextsize = 0;
+    std::int64_t rootLOC = 0;
+    // names of the element counts outside the srcML vocabulary, which the
+    // parser interns the names of start tags in, and which can have other
+    // IDs in another handler
+    ElementNames elementNames;
+    // number of start tags of each element, indexed by the ID of its name
+    std::vector<std::int64_t> elementCounts = std::vector<std::int64_t>(ElementNames::VOCABULARY_SIZE);
+    std::int64_t literalStringCount = 0;
+    std::int64_t lineCommentCount = 0;
     bool isArchive = false;
+    int unitDepth = std::numeric_limits<int>::max();
     bool inTagLiteral = false;
     bool inTagComment = false;
+    UnitRecording unitRecording = RECORD_NO_UNITS;
+    UnitStarts units;
+    bool inUnitTag = false;
+
+    /*
+        Adds the start tag of a unit, with the counts before it, whose
+        attributes are added as they are found
+        Input: Start of the tag in the parsed document, and its depth
+        Output: Added unit
+    */
+    void startUnit(const char* tag, int depth);
+
+    /*
+        Adds characters to those at the shallowest depth, which starts
+        over at a shallower depth
+        Input: Depth of the characters, their size, and their newlines
+        Output: Updated counts of the shallowest characters
+    */
+    void addRootText(int depth, std::int64_t size, std::int64_t newlineCount);
+
+    /*
+        Finds the ID of the name of a language, e.g., from the language
+        attribute of a unit, and adds the name the first time it is found
+        Input: Name of the language
+        Output: ID of the name
+    */
+    int languageID(std::string_view language);
 
     /*
         Override function that handles
@@ -37,13 +113,21 @@ private:
     */
     void handleElementStartTag(std::string_view qName, std::string_view prefix, std::string_view localName, const int &depth) override;
 
+    /*
+        Function that handles
+        element start tags, with the ID of the element name
+        Input: std::string_view qName, std::string_view prefix, std::string_view localName, int nameID, int depth
+        Output: N/A
+    */
+    void handleElementStartTag(std::string_view qName, std::string_view prefix, std::string_view localName, int nameID, const int &depth);
+
     /*
         Override function that handles
         characters
-        Input: std::string_view characters, int depth
+        Input: std::string_view characters, int newlineCount, int depth
         Output: N/A
     */
-    void handleCharacters(std::string_view characters, const int &depth) override;
+    void handleCharacters(std::string_view characters, const int &newlineCount, const int &depth) override;
 
     /*
         Override function that handles
@@ -118,6 +202,44 @@ private:
     void handleEndDocument(const int &depth) override;
 
 public:
+    // events with counts, so the parser skips the rest, e.g., end tags
+    static constexpr unsigned int eventMask = START_TAG | CHARACTERS | ATTRIBUTE | CDATA;
+
+    // start tags with the ID of the element name, so the handler switches on it
+    static constexpr bool internsNames = true;
+
+    /*
+        Adds the counts of another handler, e.g., one that parsed
+        the next part of the same document on another thread, at
+        depths that differ from the real ones by the depth offset
+        Input: Handler to merge and its depth offset
+        Output: Updated counts
+    */
+    void merge(const srcFactsParser &other, int depthOffset = 0);
+
+    /*
+        Writes the counts, e.g., to a checkpoint of a long parse between
+        units, where no tag is open in the handler
+        Input: Output stream
+        Output: Counts as text, with the elements by name
+    */
+    void save(std::ostream &out) const;
+
+    /*
+        Reads the counts written by save, in place of the current ones
+        Input: Input stream
+        Output: Restored counts; bool value for whether they were read
+    */
+    bool restore(std::istream &in);
+
+    /*
+        Adds the measures of a child unit of an archive that is not parsed,
+        e.g., one with its measures in a cache
+        Input: Counts of each UnitMeasure of the unit
+        Output: Updated counts
+    */
+    void addUnit(const UnitCounts &counts);
+
     /*
         Get method for URL
         Input: N/A
@@ -130,84 +252,88 @@ public:
         Input: N/A
         Output: Textsize
     */
-    int getTextsize();
+    std::int64_t getTextsize();
 
     /*
         Get method for LOC
         Input: N/A
         Output: LOC
     */
-    int getLOC();
+    std::int64_t getLOC();
 
     /*
-        Get method for ExprCount
-        Input: N/A
-        Output: ExprCount
+        Get method for the count of an element
+        Input: ID of the element name, e.g., ElementNames::EXPR
+        Output: Number of start tags of the element
     */
-    int getExprCount();
+    std::int64_t getElementCount(int nameID);
 
     /*
-        Get method for FunctionCount
+        Get method for ElementNames, the names of the IDs of the element counts
         Input: N/A
-        Output: FunctionCount
+        Output: ElementNames
     */
-    int getFunctionCount();
+    const ElementNames& getElementNames();
 
     /*
-        Get method for ClassCount
+        Get method for LiteralStringCount
         Input: N/A
-        Output: ClassCount
+        Output: LiteralStringCount
     */
-    int getClassCount();
+    std::int64_t getLiteralStringCount();
 
     /*
-        Get method for UnitCount
+        Get method for LineCommentCount
         Input: N/A
-        Output: UnitCount
+        Output: LineCommentCount
     */
-    int getUnitCount();
+    std::int64_t getLineCommentCount();
 
     /*
-        Get method for DeclCount
+        Get method for IsArchive
         Input: N/A
-        Output: DeclCount
+        Output: IsArchive
     */
-    int getDeclCount();
+    bool getIsArchive();
 
     /*
-        Get method for CommentCount
+        Get method for the measures of the report counted so far
         Input: N/A
-        Output: CommentCount
+        Output: Counts of each UnitMeasure
     */
-    int getCommentCount();
+    UnitCounts getUnitCounts();
 
     /*
-        Get method for ReturnCount
+        Get method for the measures of the report counted so far in the
+        child units of the root element, i.e., without its own characters
         Input: N/A
-        Output: ReturnCount
+        Output: Counts of each UnitMeasure
     */
-    int getReturnCount();
+    UnitCounts getChildUnitCounts();
 
     /*
-        Get method for LiteralStringCount
-        Input: N/A
-        Output: LiteralStringCount
+        Set method for the units that are recorded, so a parse with
+        no index or measures of each file records none
+        Input: Units to record
+        Output: N/A
     */
-    int getLiteralStringCount();
+    void setUnitRecording(UnitRecording recording);
 
     /*
-        Get method for LineCommentCount
+        Get method for the units that are recorded
         Input: N/A
-        Output: LineCommentCount
+        Output: UnitRecording
     */
-    int getLineCommentCount();
+    UnitRecording getUnitRecording();
 
     /*
-        Get method for IsArchive
+        Get method for the start tags of the units, in document order,
+        as recorded by setUnitRecording, whose tags are in the parsed
+        document only while it is in memory
         Input: N/A
-        Output: IsArchive
+        Output: Start of each unit
     */
-    bool getIsArchive();
+    const UnitStarts& getUnits();
 };
 
 #endif
@@ -0,0 +1,176 @@
+/*
+    unitcachetest.cpp
+
+    Test of the hash of UnitCache against the reference values of XXH64,
+    and of parseCached against the parse of the whole archive: a run with
+    no cache, where every unit is a miss, a run where every unit is a hit,
+    a run with a changed unit, which is a miss with the same start tag,
+    and a run with a file that is not a cache.
+
+    Output is a line for each failed check, and the exit status is the
+    number of failed checks.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include "parseCached.hpp"
+#include "UnitCache.hpp"
+#include "findUnits.hpp"
+#include "BasicXMLParser.hpp"
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+// cache file of the test, in the current directory
+const std::string CACHE_PATH = "unitcachetest.cache";
+
+namespace {
+
+    /*
+        An archive of units that each have the same text, with space between the units
+
+        @param[in] unitCount Number of units
+        @return The archive
+    */
+    std::string archive(int unitCount) {
+        std::string document = "<?xml version=\"1.0\"?>\n<unit xmlns=\"http://www.srcML.org/srcML/src\">\n\n";
+        for (int unit = 0; unit < unitCount; ++unit)
+            document += "<unit filename=\"f" + std::to_string(unit) + ".cpp\" language=\"C++\"><expr>a\nb\nc\n</expr></unit>\n\n";
+        document += "</unit>\n";
+
+        return document;
+    }
+
+    // measures of the report of a parse, with its bytes
+    struct Parse {
+        srcFactsParser::UnitCounts counts = {};
+        std::int64_t totalBytes = 0;
+    };
+
+    /*
+        Parse a whole document with no cache
+
+        @param[in] document The document
+        @return Measures of the report
+    */
+    Parse parse(std::string_view document) {
+        srcFactsParser handler;
+        BasicXMLParser<srcFactsParser> parser(handler, document);
+        if (const XMLParserError error = parser.parse())
+            std::cout << "parse: " << error.message() << '\n';
+
+        return { handler.getUnitCounts(), parser.getTotalBytes() };
+    }
+
+    /*
+        Parse a document with the cache, and check the measures against the
+        parse of the whole document
+
+        @param[in] name Name of the check
+        @param[in] document The document
+        @return Number of failed checks
+    */
+    int checkParse(std::string_view name, std::string_view document) {
+        int failed = 0;
+        const Parse expected = parse(document);
+        srcFactsParser handler;
+        bool saved = false;
+        XMLParserError error;
+        const std::int64_t totalBytes = parseCached(document, handler, CACHE_PATH, saved, error);
+        if (error) {
+            std::cout << name << ": " << error.message() << '\n';
+            ++failed;
+        }
+        if (!saved) {
+            std::cout << name << ": cache not written\n";
+            ++failed;
+        }
+        if (handler.getUnitCounts() != expected.counts || totalBytes != expected.totalBytes) {
+            std::cout << name << ": measures differ from the parse of the whole document\n";
+            ++failed;
+        }
+
+        return failed;
+    }
+
+    /*
+        Check which units of a document are in the cache file
+
+        @param[in] name Name of the check
+        @param[in] document The document
+        @param[in] changedUnit Index of the one unit that is not in the cache, or -1
+        @return Number of failed checks
+    */
+    int checkRows(std::string_view name, std::string_view document, int changedUnit) {
+        UnitCache cache;
+        if (!cache.load(CACHE_PATH)) {
+            std::cout << name << ": no cache\n";
+            return 1;
+        }
+
+        int failed = 0;
+        int unit = 0;
+        findUnits(document, [&](std::string_view startTag) {
+            const bool found = cache.find(UnitCache::hash(startTag), document.substr(std::distance(document.data(), startTag.data()))) != nullptr;
+            if (found != (unit != changedUnit)) {
+                std::cout << name << ": unit " << unit << (found ? " is" : " is not") << " in the cache\n";
+                ++failed;
+            }
+            ++unit;
+            return 0;
+        });
+
+        return failed;
+    }
+}
+
+int main() {
+    int failed = 0;
+
+    // reference values of XXH64 with seed 0
+    if (UnitCache::hash(""sv) != 0xEF46DB3751D8E999ULL) {
+        std::cout << "hash of \"\": " << std::hex << UnitCache::hash(""sv) << std::dec << '\n';
+        ++failed;
+    }
+    if (UnitCache::hash("abc"sv) != 0x44BC2CF5AD770999ULL) {
+        std::cout << "hash of \"abc\": " << std::hex << UnitCache::hash("abc"sv) << std::dec << '\n';
+        ++failed;
+    }
+
+    // every unit is a miss, and then a hit
+    const std::string document = archive(8);
+    std::remove(CACHE_PATH.c_str());
+    failed += checkParse("miss"sv, document);
+    failed += checkRows("miss"sv, document, -1);
+    failed += checkParse("hit"sv, document);
+    failed += checkRows("hit"sv, document, -1);
+
+    // a unit with the same start tag and length, and other bytes, is not in the cache
+    std::string changed = document;
+    const std::size_t text = changed.find("a\nb\nc\n", changed.find("f3.cpp"));
+    changed.replace(text, 6, "abc   ");
+    failed += checkRows("changed"sv, changed, 3);
+    failed += checkParse("changed"sv, changed);
+    failed += checkRows("changed"sv, changed, -1);
+
+    // a file that is not a cache has no rows
+    {
+        std::ofstream out(CACHE_PATH, std::ios::trunc);
+        out << "not a cache\n";
+    }
+    UnitCache cache;
+    if (cache.load(CACHE_PATH)) {
+        std::cout << "not a cache: loaded\n";
+        ++failed;
+    }
+    failed += checkParse("not a cache"sv, document);
+    failed += checkRows("not a cache"sv, document, -1);
+
+    std::remove(CACHE_PATH.c_str());
+
+    return failed;
+}
@@ -0,0 +1,120 @@
+/*
+    unitindextest.cpp
+
+    Test of the index of the units of an archive written and read back,
+    and of the checks that keep a stale index from being used: an index
+    of another version is not read, and an index does not match a
+    document of another size, or one where a selected unit has other
+    bytes of the same length.
+
+    Output is a line for each failed check, and the exit status is the
+    number of failed checks.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include "UnitIndex.hpp"
+#include "BasicXMLParser.hpp"
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+// index file of the test, in the current directory
+const std::string INDEX_PATH = "unitindextest.index";
+
+namespace {
+
+    /*
+        An archive of units that each have the same text, with space between the units
+
+        @param[in] unitCount Number of units
+        @return The archive
+    */
+    std::string archive(int unitCount) {
+        std::string document = "<?xml version=\"1.0\"?>\n<unit xmlns=\"http://www.srcML.org/srcML/src\">\n\n";
+        for (int unit = 0; unit < unitCount; ++unit)
+            document += "<unit filename=\"f" + std::to_string(unit) + ".cpp\" language=\"C++\"><expr>a\nb\nc\n</expr></unit>\n\n";
+        document += "</unit>\n";
+
+        return document;
+    }
+
+    /*
+        Check whether an index matches a document for a filename prefix
+
+        @param[in] name Name of the check
+        @param[in] index The index
+        @param[in] document The document
+        @param[in] filenamePrefix Start of the filename of the selected units
+        @param[in] expected Whether the index is expected to match
+        @return Number of failed checks
+    */
+    int checkMatch(std::string_view name, const UnitIndex& index, std::string_view document, std::string_view filenamePrefix, bool expected) {
+        if (index.matches(document, filenamePrefix) == expected)
+            return 0;
+        std::cout << name << ": index" << (expected ? " does not match" : " matches") << " for the prefix \"" << filenamePrefix << "\"\n";
+
+        return 1;
+    }
+}
+
+int main() {
+    int failed = 0;
+
+    // index of the parse of the whole archive, written and read back
+    const std::string document = archive(8);
+    srcFactsParser handler;
+    handler.setUnitRecording(srcFactsParser::RECORD_UNIT_TAGS);
+    BasicXMLParser<srcFactsParser> parser(handler, std::string_view(document));
+    if (const XMLParserError error = parser.parse()) {
+        std::cout << "parse: " << error.message() << '\n';
+        ++failed;
+    }
+    if (!UnitIndex(document, handler).save(INDEX_PATH)) {
+        std::cout << "index not written\n";
+        return failed + 1;
+    }
+    UnitIndex index;
+    if (!index.load(INDEX_PATH) || index.getEntries().size() != 8) {
+        std::cout << "index read with " << index.getEntries().size() << " units instead of 8\n";
+        ++failed;
+    }
+    failed += checkMatch("same document"sv, index, document, ""sv, true);
+
+    // a document of another size
+    failed += checkMatch("other size"sv, index, document + "\n", ""sv, false);
+
+    // a unit with other bytes of the same length only matches when it is not selected
+    std::string changed = document;
+    const std::size_t text = changed.find("a\nb\nc\n", changed.find("f3.cpp"));
+    changed.replace(text, 6, "abc   ");
+    failed += checkMatch("changed unit"sv, index, changed, ""sv, false);
+    failed += checkMatch("changed unit"sv, index, changed, "f3"sv, false);
+    failed += checkMatch("changed unit"sv, index, changed, "f1"sv, true);
+
+    // an index of another version is not read
+    std::string contents;
+    {
+        std::ifstream in(INDEX_PATH);
+        std::ostringstream out;
+        out << in.rdbuf();
+        contents = out.str();
+    }
+    {
+        std::ofstream out(INDEX_PATH, std::ios::trunc);
+        out << "srcFacts unit index 1" << contents.substr(contents.find('\n'));
+    }
+    UnitIndex oldIndex;
+    if (oldIndex.load(INDEX_PATH)) {
+        std::cout << "index of another version read\n";
+        ++failed;
+    }
+
+    std::remove(INDEX_PATH.c_str());
+
+    return failed;
+}
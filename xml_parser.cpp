@@ -131,8 +131,7 @@ void parseNamespace(std::string::const_iterator &cursor, std::string::const_iter
     std::advance(cursor, 5);
     const auto nameEnd = std::find(cursor, cursorEnd, '=');
     if (nameEnd == cursorEnd) {
-        std::cerr << "parser error : incomplete namespace\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INCOMPLETE_NAMESPACE};
     }
     int prefixSize = 0;
     if (*cursor == ':') {
@@ -144,19 +143,16 @@ void parseNamespace(std::string::const_iterator &cursor, std::string::const_iter
     cursor = std::next(nameEnd);
     cursor = std::find_if_not(cursor, cursorEnd, isspace);
     if (cursor == cursorEnd) {
-        std::cerr << "parser error : incomplete namespace\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INCOMPLETE_NAMESPACE};
     }
     const char delimiter = *cursor;
     if (delimiter != '"' && delimiter != '\'') {
-        std::cerr << "parser error : incomplete namespace\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INCOMPLETE_NAMESPACE};
     }
     std::advance(cursor, 1);
     const auto valueEnd = std::find(cursor, cursorEnd, delimiter);
     if (valueEnd == cursorEnd) {
-        std::cerr << "parser error : incomplete namespace\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INCOMPLETE_NAMESPACE};
     }
     const std::string_view uriTemp(std::addressof(*cursor), std::distance(cursor, valueEnd));
     uri = uriTemp;
@@ -183,15 +179,13 @@ void parseNamespace(std::string::const_iterator &cursor, std::string::const_iter
 */
 void parseAttribute(std::string::const_iterator &cursor, std::string::const_iterator &cursorEnd, const std::string::const_iterator &nameEnd, bool &inTag, int &depth, const std::string_view &inTagPrefix, const std::string &inTagQName, const std::string_view &inTagLocalName, std::string_view &qName, std::string_view &prefix, std::string_view &localName, std::string_view &value){
     if (nameEnd == cursorEnd) {
-        std::cerr << "parser error : Empty attribute name" << '\n';
-        exit(1);
+        throw XMLParserError{XMLParserError::EMPTY_ATTRIBUTE_NAME};
     }
     const std::string_view qNameTemp(std::addressof(*cursor), std::distance(cursor, nameEnd));
     qName = qNameTemp;
     size_t colonPosition = qNameTemp.find(':');
     if (colonPosition == 0) {
-        std::cerr << "parser error : Invalid attribute name " << qNameTemp << '\n';
-        exit(1);
+        throw XMLParserError{XMLParserError::INVALID_ATTRIBUTE_NAME};
     }
     if (colonPosition == std::string::npos)
         colonPosition = 0;
@@ -205,26 +199,22 @@ void parseAttribute(std::string::const_iterator &cursor, std::string::const_iter
     if (isspace(*cursor))
         cursor = std::find_if_not(cursor, cursorEnd, isspace);
     if (cursor == cursorEnd) {
-        std::cerr << "parser error : attribute " << qNameTemp << " incomplete attribute\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INCOMPLETE_ATTRIBUTE};
     }
     if (*cursor != '=') {
-        std::cerr << "parser error : attribute " << qNameTemp << " missing =\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::MISSING_ATTRIBUTE_EQUALS};
     }
     std::advance(cursor, 1);
     if (isspace(*cursor))
         cursor = std::find_if_not(cursor, cursorEnd, isspace);
     const char delimiter = *cursor;
     if (delimiter != '"' && delimiter != '\'') {
-        std::cerr << "parser error : attribute " << qNameTemp << " missing delimiter\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::MISSING_ATTRIBUTE_DELIMITER};
     }
     std::advance(cursor, 1);
     auto valueEnd = std::find(cursor, cursorEnd, delimiter);
     if (valueEnd == cursorEnd) {
-        std::cerr << "parser error : attribute " << qNameTemp << " missing delimiter\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::MISSING_ATTRIBUTE_DELIMITER};
     }
     const std::string_view valueTemp(std::addressof(*cursor), std::distance(cursor, valueEnd));
     value = valueTemp;
@@ -252,8 +242,7 @@ void parseAttribute(std::string::const_iterator &cursor, std::string::const_iter
 */
 void parseComment(std::string::const_iterator &cursor, std::string::const_iterator &cursorEnd, bool &inXMLComment, std::string_view &comment){
     if (cursor == cursorEnd) {
-        std::cerr << "parser error : Unterminated XML comment\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::UNTERMINATED_XML_COMMENT};
     }
     if (!inXMLComment)
         std::advance(cursor, 4);
@@ -279,8 +268,7 @@ void parseComment(std::string::const_iterator &cursor, std::string::const_iterat
 */
 void parseCDATA(std::string::const_iterator &cursor, std::string::const_iterator &cursorEnd, bool &inCDATA, std::string_view &characters){
     if (cursor == cursorEnd) {
-        std::cerr << "parser error : Unterminated CDATA\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::UNTERMINATED_CDATA};
     }
     constexpr std::string_view endCDATA = "]]>"sv;
     if (!inCDATA)
@@ -308,26 +296,22 @@ void parseCDATA(std::string::const_iterator &cursor, std::string::const_iterator
 void parseDeclaration(std::string::const_iterator &cursor, std::string::const_iterator &cursorEnd, const std::string_view &startXMLDecl, const std::string_view &endXMLDecl, std::string::const_iterator &tagEnd, std::string_view &version, std::optional<std::string_view> &encoding, std::optional<std::string_view> &standalone){
     // parse required version
     if (cursor == tagEnd) {
-        std::cerr << "parser error: Missing space after before version in XML declaration\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INCOMPLETE_XML_DECLARATION};
     }
     auto nameEnd = std::find(cursor, tagEnd, '=');
     const std::string_view attr(std::addressof(*cursor), std::distance(cursor, nameEnd));
     cursor = std::next(nameEnd);
     const char delimiter = *cursor;
     if (delimiter != '"' && delimiter != '\'') {
-        std::cerr << "parser error: Invalid start delimiter for version in XML declaration\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INVALID_XML_DECLARATION};
     }
     std::advance(cursor, 1);
     auto valueEnd = std::find(cursor, tagEnd, delimiter);
     if (valueEnd == tagEnd) {
-        std::cerr << "parser error: Invalid end delimiter for version in XML declaration\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INVALID_XML_DECLARATION};
     }
     if (attr != "version"sv) {
-        std::cerr << "parser error: Missing required first attribute version in XML declaration\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INVALID_XML_DECLARATION};
     }
     const std::string_view versionTemp(std::addressof(*cursor), std::distance(cursor, valueEnd));
     version = versionTemp;
@@ -340,29 +324,25 @@ void parseDeclaration(std::string::const_iterator &cursor, std::string::const_it
     if (cursor != (tagEnd - 1)) {
         nameEnd = std::find(cursor, tagEnd, '=');
         if (nameEnd == tagEnd) {
-            std::cerr << "parser error: Incomplete attribute in XML declaration\n";
-            exit(1);
+            throw XMLParserError{XMLParserError::INCOMPLETE_XML_DECLARATION};
         }
         const std::string_view attr2(std::addressof(*cursor), std::distance(cursor, nameEnd));
         cursor = std::next(nameEnd);
         char delimiter2 = *cursor;
         if (delimiter2 != '"' && delimiter2 != '\'') {
-            std::cerr << "parser error: Invalid end delimiter for attribute " << attr2 << " in XML declaration\n";
-            exit(1);
+            throw XMLParserError{XMLParserError::INVALID_XML_DECLARATION};
         }
         std::advance(cursor, 1);
         valueEnd = std::find(cursor, tagEnd, delimiter2);
         if (valueEnd == tagEnd) {
-            std::cerr << "parser error: Incomplete attribute " << attr2 << " in XML declaration\n";
-            exit(1);
+            throw XMLParserError{XMLParserError::INCOMPLETE_XML_DECLARATION};
         }
         if (attr2 == "encoding"sv) {
             encodingTemp = std::string_view(std::addressof(*cursor), std::distance(cursor, valueEnd));
         } else if (attr2 == "standalone"sv) {
             standaloneTemp = std::string_view(std::addressof(*cursor), std::distance(cursor, valueEnd));
         } else {
-            std::cerr << "parser error: Invalid attribute " << attr2 << " in XML declaration\n";
-            exit(1);
+            throw XMLParserError{XMLParserError::INVALID_XML_DECLARATION};
         }
         cursor = std::next(valueEnd);
         cursor = std::find_if_not(cursor, tagEnd, isspace);
@@ -370,27 +350,23 @@ void parseDeclaration(std::string::const_iterator &cursor, std::string::const_it
     if (cursor != (tagEnd - endXMLDecl.size() + 1)) {
         nameEnd = std::find(cursor, tagEnd, '=');
         if (nameEnd == tagEnd) {
-            std::cerr << "parser error: Incomplete attribute in XML declaration\n";
-            exit(1);
+            throw XMLParserError{XMLParserError::INCOMPLETE_XML_DECLARATION};
         }
         const std::string_view attr2(std::addressof(*cursor), std::distance(cursor, nameEnd));
         cursor = std::next(nameEnd);
         const char delimiter2 = *cursor;
         if (delimiter2 != '"' && delimiter2 != '\'') {
-            std::cerr << "parser error: Invalid end delimiter for attribute " << attr2 << " in XML declaration\n";
-            exit(1);
+            throw XMLParserError{XMLParserError::INVALID_XML_DECLARATION};
         }
         std::advance(cursor, 1);
         valueEnd = std::find(cursor, tagEnd, delimiter2);
         if (valueEnd == tagEnd) {
-            std::cerr << "parser error: Incomplete attribute " << attr2 << " in XML declaration\n";
-            exit(1);
+            throw XMLParserError{XMLParserError::INCOMPLETE_XML_DECLARATION};
         }
         if (!standaloneTemp && attr2 == "standalone"sv) {
             standaloneTemp = std::string_view(std::addressof(*cursor), std::distance(cursor, valueEnd));
         } else {
-            std::cerr << "parser error: Invalid attribute " << attr2 << " in XML declaration\n";
-            exit(1);
+            throw XMLParserError{XMLParserError::INVALID_XML_DECLARATION};
         }
         cursor = std::next(valueEnd);
         cursor = std::find_if_not(cursor, tagEnd, isspace);
@@ -411,8 +387,7 @@ void parseDeclaration(std::string::const_iterator &cursor, std::string::const_it
 */
 void parseProcessInstr(std::string::const_iterator &cursor, std::string::const_iterator &cursorEnd, std::string::const_iterator &tagEnd, std::string::const_iterator &nameEnd, std::string_view &target, std::string_view &data){
     if (nameEnd == tagEnd) {
-        std::cerr << "parser error : Unterminated processing instruction '" << std::string_view(std::addressof(*cursor), std::distance(cursor, nameEnd)) << "'\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::UNTERMINATED_PROCESSING_INSTRUCTION};
     }
     const std::string_view targetTemp(std::addressof(*cursor), std::distance(cursor, nameEnd));
     target = targetTemp;
@@ -437,8 +412,7 @@ void parseEndTag(std::string::const_iterator &cursor, std::string::const_iterato
     const std::string_view qNameTemp(std::addressof(*cursor), std::distance(cursor, nameEnd));
     qName = qNameTemp;
     if (qNameTemp.empty()) {
-        std::cerr << "parser error: EndTag: invalid element name\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INVALID_END_TAG_NAME};
     }
     if (colonPosition)
         ++colonPosition;
@@ -462,8 +436,7 @@ void parseStartTag(std::string::const_iterator &cursor, std::string::const_itera
     const std::string_view qNameTemp(std::addressof(*cursor), std::distance(cursor, nameEnd));
     qName = qNameTemp;
     if (qName.empty()) {
-        std::cerr << "parser error: StartTag: invalid element name\n";
-        exit(1);
+        throw XMLParserError{XMLParserError::INVALID_START_TAG_NAME};
     }
     if (colonPosition)
         ++colonPosition;
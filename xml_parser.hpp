@@ -3,6 +3,7 @@
     xml_parser.hpp
 
     Include file for low-level XML parsing functions
+    A malformed construct throws an XMLParserError with its code
 
 */
 
@@ -11,6 +12,7 @@
 
 #include <string>
 #include <optional>
+#include "XMLParserError.hpp"
 
 /*
     Traces the start of an XML document
@@ -0,0 +1,352 @@
+/*
+    xmlbench.cpp
+
+    Benchmark of the XML parser input modes. Each srcML file given on
+    the command line is parsed with the srcFacts handler once per input
+    mode, by default from a cold page cache. Then the file is parsed in
+    memory with the handler called virtually, by XMLParser, and
+    statically, by BasicXMLParser<srcFactsParser>, with the branch
+    misses of the parse when the processor counters are available,
+    and with the content of each unit skipped, e.g., for a query of
+    only the unit metadata. Last, 10,000 small units are parsed as
+    separate documents, with a new parser for each, and with one
+    parser reset for each, as in a long-running service.
+
+    Output is a markdown table with the time and throughput of each run.
+
+    Usage:
+    * xmlbench [--warm] file...
+    * xmlbench --generate MB unit.xml archive.xml
+
+    --generate writes a synthetic srcML archive of about MB megabytes by
+    repeating the root unit of unit.xml, e.g., for a multi-GB input.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+#include <fcntl.h>
+#include "XMLParser.hpp"
+#include "BasicXMLParser.hpp"
+#include "srcFactsParser.hpp"
+#include "MappedFile.hpp"
+#include "ReadAheadInput.hpp"
+#include "UringInput.hpp"
+
+#if !defined(_MSC_VER)
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+const int BUFFER_SIZE = 16 * 16 * 4096;
+
+// number of documents of the parser reuse benchmark
+const int SMALL_UNIT_COUNT = 10000;
+
+/*
+    Writes a synthetic srcML archive by repeating the root unit of a file
+    Input: Size in megabytes, path of the unit file, path of the archive
+    Output: Archive file; bool value for success
+*/
+bool generate(long megabytes, const std::string &unitPath, const std::string &archivePath) {
+    std::ifstream in(unitPath, std::ios::binary);
+    const std::string source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto unitStart = source.find("<unit");
+    if (unitStart == std::string::npos) {
+        std::cerr << "xmlbench: No unit in " << unitPath << '\n';
+        return false;
+    }
+    const auto unitEnd = source.rfind("</unit>");
+    const std::string_view unit(source.data() + unitStart, unitEnd + 7 - unitStart);
+
+    std::ofstream out(archivePath, std::ios::binary);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+    out << "<unit xmlns=\"http://www.srcML.org/srcML/src\" xmlns:cpp=\"http://www.srcML.org/srcML/cpp\" revision=\"1.0.0\" url=\"synthetic\">\n\n";
+    const long long total = megabytes * 1024LL * 1024LL;
+    for (long long written = 0; written < total; written += unit.size() + 2)
+        out << unit << "\n\n";
+    out << "</unit>\n";
+
+    return static_cast<bool>(out);
+}
+
+/*
+    Drops the cached pages of a file, so the next read is from the device
+    Input: File descriptor
+    Output: N/A
+*/
+void dropCache(int fd) {
+#if defined(POSIX_FADV_DONTNEED)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+}
+
+/*
+    Parses a file once with the given input mode and prints a table row
+    Input: Path of the file, input mode, and if the page cache is dropped first
+    Output: Table row
+*/
+void run(const std::string &path, std::string_view mode, bool cold) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "xmlbench: Unable to open file " << path << '\n';
+        return;
+    }
+    if (cold)
+        dropCache(fd);
+    dup2(fd, 0);
+    close(fd);
+    lseek(0, 0, SEEK_SET);
+
+    const auto start = std::chrono::steady_clock::now();
+    srcFactsParser handler;
+    std::unique_ptr<MappedFile> file;
+    std::unique_ptr<XMLParserInput> input;
+    std::unique_ptr<char[]> buffer;
+    std::unique_ptr<XMLParser> parser;
+    std::string_view detail;
+    if (mode == "mmap"sv) {
+        file = std::make_unique<MappedFile>(path);
+        parser = std::make_unique<XMLParser>(handler, file->view());
+    } else if (mode == "read"sv) {
+        buffer.reset(new char[BUFFER_SIZE]);
+        parser = std::make_unique<XMLParser>(handler, buffer.get(), BUFFER_SIZE);
+    } else if (mode == "readahead"sv) {
+        input = std::make_unique<ReadAheadInput>(0, BUFFER_SIZE);
+        parser = std::make_unique<XMLParser>(handler, *input);
+    } else {
+        auto uringInput = std::make_unique<UringInput>(0, BUFFER_SIZE);
+        if (!uringInput->isUring())
+            detail = " (read() fallback)"sv;
+        input = std::move(uringInput);
+        parser = std::make_unique<XMLParser>(handler, *input);
+    }
+    parser->parse();
+    const auto finish = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(finish - start).count();
+    const double megabytes = parser->getTotalBytes() / (1024.0 * 1024.0);
+
+    std::cout << "| " << std::setw(9) << std::left << mode << std::right << " | "
+              << std::setw(8) << std::fixed << std::setprecision(3) << seconds << " | "
+              << std::setw(8) << std::setprecision(1) << megabytes / seconds << " |" << detail << '\n';
+}
+
+/*
+    Opens a counter of the branch misses of this thread
+    Input: N/A
+    Output: File descriptor of the counter, -1 if unavailable
+*/
+int openBranchMisses() {
+#if defined(__linux__)
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#else
+    return -1;
+#endif
+}
+
+// handler that counts the units of an archive, and skips their content
+struct UnitSkipper {
+    static constexpr unsigned int eventMask = XMLParserHandler::START_TAG;
+
+    BasicXMLParser<UnitSkipper>* parser = nullptr;
+    long units = 0;
+
+    void handleElementStartTag(std::string_view, std::string_view, std::string_view localName, const int &depth) {
+        if (depth == 1 && localName == "unit"sv) {
+            ++units;
+            parser->skipElement();
+        }
+    }
+};
+
+/*
+    Parses a file in memory with the given parser, the best of a few runs,
+    and prints a table row
+    Input: Mapped file and name of the dispatch
+    Output: Table row
+*/
+template <class Parser, class Handler = srcFactsParser>
+void runDispatch(const MappedFile &file, std::string_view dispatch) {
+    double best = 0;
+    long long bestMisses = -1;
+    std::int64_t totalBytes = 0;
+    const int counter = openBranchMisses();
+    for (int i = 0; i < 3; ++i) {
+#if defined(__linux__)
+        if (counter != -1) {
+            ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+            ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+        const auto start = std::chrono::steady_clock::now();
+        Handler handler;
+        Parser parser(handler, file.view());
+        if constexpr (std::is_same_v<Handler, UnitSkipper>)
+            handler.parser = &parser;
+        parser.parse();
+        const auto finish = std::chrono::steady_clock::now();
+        long long misses = -1;
+#if defined(__linux__)
+        if (counter != -1) {
+            ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(counter, &misses, sizeof(misses)) != sizeof(misses))
+                misses = -1;
+        }
+#endif
+        const double seconds = std::chrono::duration<double>(finish - start).count();
+        if (i == 0 || seconds < best) {
+            best = seconds;
+            bestMisses = misses;
+        }
+        totalBytes = parser.getTotalBytes();
+    }
+    if (counter != -1)
+        close(counter);
+    const double megabytes = totalBytes / (1024.0 * 1024.0);
+
+    std::cout << "| " << std::setw(9) << std::left << dispatch << std::right << " | "
+              << std::setw(8) << std::fixed << std::setprecision(3) << best << " | "
+              << std::setw(8) << std::setprecision(1) << megabytes / best << " | "
+              << std::setw(13);
+    if (bestMisses >= 0)
+        std::cout << bestMisses;
+    else
+        std::cout << "n/a";
+    std::cout << " |\n";
+}
+
+/*
+    Parses many small documents in memory, with a new parser for each, with
+    a new parser and buffer for each, as for a file read with read(), and
+    with one parser reset for each, the best of a few runs, and prints a
+    table row for each
+    Input: N/A
+    Output: Table rows
+*/
+void runReuse() {
+    std::vector<std::string> units;
+    for (int i = 0; i < SMALL_UNIT_COUNT; ++i) {
+        units.push_back("<unit xmlns=\"http://www.srcML.org/srcML/src\" revision=\"1.0.0\" language=\"C++\" filename=\"file"
+            + std::to_string(i) + ".cpp\"><function><type><name>int</name></type> <name>f</name><parameter_list>(<parameter><decl>"
+            "<type><name>int</name></type> <name>n</name></decl></parameter>)</parameter_list> <block>{<block_content>\n"
+            "    <return>return <expr><name>n</name> <operator>+</operator> <literal type=\"number\">1</literal></expr>;</return>\n"
+            "</block_content>}</block></function>\n</unit>\n");
+    }
+
+    const auto runUnits = [&](std::string_view reuse, const std::function<std::int64_t(srcFactsParser&)>& parseUnits) {
+        double best = 0;
+        std::int64_t totalBytes = 0;
+        for (int i = 0; i < 3; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            srcFactsParser handler;
+            totalBytes = parseUnits(handler);
+            const auto finish = std::chrono::steady_clock::now();
+            const double seconds = std::chrono::duration<double>(finish - start).count();
+            if (i == 0 || seconds < best)
+                best = seconds;
+        }
+        const double megabytes = totalBytes / (1024.0 * 1024.0);
+
+        std::cout << "| " << std::setw(9) << std::left << reuse << std::right << " | "
+                  << std::setw(8) << std::fixed << std::setprecision(3) << best << " | "
+                  << std::setw(8) << std::setprecision(1) << megabytes / best << " | "
+                  << std::setw(9) << std::setprecision(0) << units.size() / best << " |\n";
+    };
+
+    std::cout << "# xmlbench: " << SMALL_UNIT_COUNT << " small units\n";
+    std::cout << "| Parser    |  Seconds |     MB/s |   Units/s |\n";
+    std::cout << "|:----------|---------:|---------:|----------:|\n";
+    runUnits("new"sv, [&](srcFactsParser& handler) {
+        std::int64_t totalBytes = 0;
+        for (const auto& unit : units) {
+            BasicXMLParser<srcFactsParser> parser(handler, std::string_view(unit));
+            parser.parse();
+            totalBytes += parser.getTotalBytes();
+        }
+        return totalBytes;
+    });
+    runUnits("new+1MiB"sv, [&](srcFactsParser& handler) {
+        std::int64_t totalBytes = 0;
+        for (const auto& unit : units) {
+            BasicXMLParser<srcFactsParser> parser(handler, std::string(BUFFER_SIZE, '\0'));
+            parser.parse(unit);
+            totalBytes += parser.getTotalBytes();
+        }
+        return totalBytes;
+    });
+    runUnits("reset"sv, [&](srcFactsParser& handler) {
+        std::int64_t totalBytes = 0;
+        BasicXMLParser<srcFactsParser> parser(handler, std::string_view());
+        for (const auto& unit : units) {
+            parser.parse(unit);
+            totalBytes += parser.getTotalBytes();
+        }
+        return totalBytes;
+    });
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> paths;
+    bool cold = true;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--generate"sv) {
+            if (i + 3 >= argc) {
+                std::cerr << "xmlbench: --generate MB unit.xml archive.xml\n";
+                return 1;
+            }
+            return generate(std::stol(argv[i + 1]), argv[i + 2], argv[i + 3]) ? 0 : 1;
+        } else if (arg == "--warm"sv) {
+            cold = false;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    for (const auto& path : paths) {
+        std::cout << "# xmlbench: " << path << (cold ? " (cold cache)" : " (warm cache)") << '\n';
+        std::cout << "| Input     |  Seconds |     MB/s |\n";
+        std::cout << "|:----------|---------:|---------:|\n";
+        for (const auto mode : { "read"sv, "readahead"sv, "uring"sv, "mmap"sv })
+            run(path, mode, cold);
+
+        const MappedFile file(path);
+        if (!file.isValid()) {
+            std::cerr << "xmlbench: Unable to map file " << path << '\n';
+            continue;
+        }
+        std::cout << '\n';
+        std::cout << "| Dispatch  |  Seconds |     MB/s | Branch misses |\n";
+        std::cout << "|:----------|---------:|---------:|--------------:|\n";
+        runDispatch<XMLParser>(file, "virtual"sv);
+        runDispatch<BasicXMLParser<srcFactsParser>>(file, "static"sv);
+        runDispatch<BasicXMLParser<UnitSkipper>, UnitSkipper>(file, "skip unit"sv);
+        std::cout << '\n';
+    }
+    runReuse();
+
+    return 0;
+}
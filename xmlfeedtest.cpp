@@ -0,0 +1,174 @@
+/*
+    xmlfeedtest.cpp
+
+    Test of a document pushed to BasicXMLParser with feed() and finish()
+    against the parse of the whole document in memory. The document is fed
+    in blocks of each size from 1 byte to its whole size, so the blocks cut
+    it inside a comment, CDATA, an attribute value, a name, and every other
+    token. Characters, comments, and CDATA cut by a block may be handled in
+    pieces, so adjacent pieces are joined before the events are compared.
+
+    Output is a line for each failed check, and the exit status is the
+    number of failed checks.
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BasicXMLParser.hpp"
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+namespace {
+
+    // event of the handler, with its depth, and its names and values joined
+    struct Record {
+        XMLParserHandler::Event kind;
+        int depth;
+        std::string text;
+        int newlineCount;
+
+        bool operator==(const Record& other) const {
+            return kind == other.kind && depth == other.depth && text == other.text && newlineCount == other.newlineCount;
+        }
+        bool operator!=(const Record& other) const {
+            return !(*this == other);
+        }
+    };
+
+    // handler that records all of its events
+    class RecordingHandler final : public XMLParserHandler {
+    public:
+        std::vector<Record> records;
+
+        void handleStartDocument(const int &depth) override {
+            add(START_DOCUMENT, depth, ""sv);
+        }
+
+        void handleXMLDeclaration(std::string_view version, const std::optional<std::string_view> &encoding, const std::optional<std::string_view> &standalone, const int &depth) override {
+            add(XML_DECLARATION, depth, std::string(version) + "|" + std::string(encoding.value_or("-"sv)) + "|" + std::string(standalone.value_or("-"sv)));
+        }
+
+        void handleElementStartTag(std::string_view qName, std::string_view prefix, std::string_view localName, const int &depth) override {
+            add(START_TAG, depth, std::string(qName) + "|" + std::string(prefix) + "|" + std::string(localName));
+        }
+
+        void handleElementEndTag(std::string_view qName, std::string_view prefix, std::string_view localName, const int &depth) override {
+            add(END_TAG, depth, std::string(qName) + "|" + std::string(prefix) + "|" + std::string(localName));
+        }
+
+        void handleCharacters(std::string_view characters, const int &newlineCount, const int &depth) override {
+            add(CHARACTERS, depth, characters, newlineCount);
+        }
+
+        void handleAttribute(std::string_view qName, std::string_view prefix, std::string_view localName, std::string_view value, const int &depth) override {
+            add(ATTRIBUTE, depth, std::string(qName) + "|" + std::string(prefix) + "|" + std::string(localName) + "|" + std::string(value));
+        }
+
+        void handleXMLNamespace(std::string_view prefix, std::string_view uri, const int &depth) override {
+            add(XML_NAMESPACE, depth, std::string(prefix) + "|" + std::string(uri));
+        }
+
+        void handleXMLComment(std::string_view value, const int &depth) override {
+            add(XML_COMMENT, depth, value);
+        }
+
+        void handleCDATA(std::string_view content, const int &depth) override {
+            add(CDATA, depth, content);
+        }
+
+        void handleProcessingInstruction(std::string_view target, std::string_view data, const int &depth) override {
+            add(PROCESSING_INSTRUCTION, depth, std::string(target) + "|" + std::string(data));
+        }
+
+        void handleEndDocument(const int &depth) override {
+            add(END_DOCUMENT, depth, ""sv);
+        }
+
+    private:
+        /*
+            Record an event, joined to the last one for a piece of the same
+            characters, comment, or CDATA
+
+            @param[in] kind Kind of the event
+            @param[in] depth Depth of the event
+            @param[in] text Names and values of the event
+            @param[in] newlineCount Number of newlines of characters
+        */
+        void add(Event kind, int depth, std::string_view text, int newlineCount = 0) {
+            const bool joined = kind == CHARACTERS || kind == XML_COMMENT || kind == CDATA;
+            if (joined && !records.empty() && records.back().kind == kind && records.back().depth == depth) {
+                records.back().text.append(text);
+                records.back().newlineCount += newlineCount;
+                return;
+            }
+            records.push_back(Record{ kind, depth, std::string(text), newlineCount });
+        }
+    };
+
+    /*
+        Feed a document in blocks of each size, and check the events and
+        error against the parse of the whole document
+
+        @param[in] name Name of the check
+        @param[in] document The document
+        @return Number of failed checks
+    */
+    int check(std::string_view name, const std::string& document) {
+        RecordingHandler expected;
+        BasicXMLParser<RecordingHandler> wholeParser(expected, std::string_view(document));
+        const XMLParserError expectedError = wholeParser.parse();
+
+        int failed = 0;
+        for (std::size_t blockSize = 1; blockSize <= document.size(); ++blockSize) {
+            RecordingHandler handler;
+            BasicXMLParser<RecordingHandler> parser(handler, std::string_view());
+            XMLParserError error;
+            for (std::size_t offset = 0; offset < document.size() && !error; offset += blockSize) {
+                // each block is a copy, reused after the call, as from a read
+                const std::string block = document.substr(offset, blockSize);
+                error = parser.feed(block.data(), block.size());
+            }
+            if (!error)
+                error = parser.finish();
+
+            if (handler.records != expected.records) {
+                std::size_t event = 0;
+                while (event < handler.records.size() && event < expected.records.size() && handler.records[event] == expected.records[event])
+                    ++event;
+                std::cout << name << " in blocks of " << blockSize << ": events differ from event " << event << '\n';
+                ++failed;
+            }
+            if (error.code != expectedError.code || error.line != expectedError.line || error.column != expectedError.column) {
+                std::cout << name << " in blocks of " << blockSize << ": " << error.message() << " at " << error.line << ":" << error.column
+                          << " instead of " << expectedError.message() << " at " << expectedError.line << ":" << expectedError.column << '\n';
+                ++failed;
+            }
+        }
+
+        return failed;
+    }
+}
+
+int main() {
+    int failed = 0;
+
+    // a document with each kind of token, with long names and values so that each is cut by many blocks
+    failed += check("document"sv,
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<unit xmlns=\"http://www.srcML.org/srcML/src\" xmlns:cpp=\"http://www.srcML.org/srcML/cpp\" filename=\"a long file name.cpp\">\n"
+        "<!-- a comment with <tags> and -- dashes in it -->\n"
+        "<cpp:include>#<cpp:directive>include</cpp:directive> <cpp:file>&lt;iostream&gt;</cpp:file></cpp:include>\n"
+        "<function_declaration><name attribute_name='single quoted value'>main</name></function_declaration>\n"
+        "<![CDATA[ CDATA with <tags> and ]] brackets ]]>\n"
+        "<?target processing instruction data?>\n"
+        "<empty_element_with_a_long_name/>&amp; text &quot;after&quot; it\n"
+        "</unit>\n");
+
+    // an error after the root element is at the same position in every block size
+    failed += check("junk after root"sv, "<a><!-- comment --><b attribute=\"value\"/></a>junk<");
+
+    return failed;
+}
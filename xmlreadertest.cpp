@@ -0,0 +1,121 @@
+/*
+    xmlreadertest.cpp
+
+    Test of the tokens and errors of XMLReader at the end of a document,
+    and on an error in its first token. Each document is read from memory,
+    and through a pipe with ReadAheadInput, which must give the same
+    tokens and error, and the reads must end.
+
+    Output is a line for each failed check, and the exit status is the
+    number of failed checks.
+*/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+#include "XMLReader.hpp"
+#include "ReadAheadInput.hpp"
+
+// provides literal string operator""sv
+using namespace std::literals::string_view_literals;
+
+// more tokens than any of the documents has, so a read that does not end fails
+const int MAXIMUM_TOKENS = 100;
+
+namespace {
+
+    // kinds of the tokens of a read, and the error that ended it
+    struct Read {
+        std::vector<XMLParserHandler::Event> kinds;
+        XMLParserError error;
+    };
+
+    /*
+        Read the tokens of a document up to its end
+
+        @param[in, out] reader Reader of the document
+        @return Kinds of the tokens, and the error
+    */
+    Read readAll(XMLReader& reader) {
+        Read read;
+        while (read.kinds.size() < MAXIMUM_TOKENS) {
+            read.kinds.push_back(reader.next().kind);
+            if (read.kinds.back() == XMLParserHandler::END_DOCUMENT)
+                break;
+        }
+        read.error = reader.getError();
+
+        return read;
+    }
+
+    /*
+        Read a document from memory, and from a pipe, and check its tokens and error
+
+        @param[in] name Name of the check
+        @param[in] document The document
+        @param[in] kinds Expected kinds of the tokens
+        @param[in] code Expected error
+        @param[in] column Expected column of the error, on the first line
+        @return Number of failed checks
+    */
+    int check(std::string_view name, const std::string& document, const std::vector<XMLParserHandler::Event>& kinds,
+        XMLParserError::Code code, std::int64_t column) {
+
+        int failed = 0;
+        const auto compare = [&](std::string_view mode, const Read& read) {
+            if (read.kinds != kinds) {
+                std::cout << name << " " << mode << ": " << read.kinds.size() << " tokens instead of " << kinds.size() << '\n';
+                ++failed;
+            }
+            if (read.error.code != code || (code != XMLParserError::NONE && read.error.column != column)) {
+                std::cout << name << " " << mode << ": " << read.error.message() << " at column " << read.error.column << '\n';
+                ++failed;
+            }
+        };
+
+        XMLReader memoryReader(document);
+        compare("memory"sv, readAll(memoryReader));
+
+        int pipeFDs[2];
+        if (pipe(pipeFDs) == -1 || write(pipeFDs[1], document.data(), document.size()) != static_cast<ssize_t>(document.size())) {
+            std::cout << name << ": Unable to write the pipe\n";
+            return failed + 1;
+        }
+        close(pipeFDs[1]);
+        {
+            ReadAheadInput input(pipeFDs[0], 4096);
+            XMLReader pipeReader(input);
+            compare("pipe"sv, readAll(pipeReader));
+        }
+        close(pipeFDs[0]);
+
+        return failed;
+    }
+}
+
+int main() {
+    using Event = XMLParserHandler::Event;
+    int failed = 0;
+
+    // characters after the root element end the read with an error
+    failed += check("junk after root"sv, "<a><b/></a>junk<",
+        { Event::START_DOCUMENT, Event::START_TAG, Event::START_TAG, Event::END_TAG, Event::END_DOCUMENT },
+        XMLParserError::CHARACTERS_OUTSIDE_ROOT, 12);
+
+    // an error in the first token is after the start of the document, with no other token
+    failed += check("error in first token"sv, "<!x>",
+        { Event::START_DOCUMENT, Event::END_DOCUMENT },
+        XMLParserError::INVALID_START_TAG_NAME, 1);
+    failed += check("unterminated first comment"sv, "<!-- a",
+        { Event::START_DOCUMENT, Event::XML_COMMENT, Event::END_DOCUMENT },
+        XMLParserError::UNTERMINATED_XML_COMMENT, 1);
+
+    // a whole document shorter than the lookahead of a buffer
+    failed += check("short document"sv, "<a/>",
+        { Event::START_DOCUMENT, Event::START_TAG, Event::END_DOCUMENT },
+        XMLParserError::NONE, 0);
+
+    return failed;
+}